@@ -0,0 +1,77 @@
+#ifndef FFT_H
+#define FFT_H
+
+
+/**
+ * @brief Opaque plan for a real-input radix-2 Fast Fourier Transform.
+ *
+ * The plan holds the precomputed twiddle factors and bit-reversal table for one
+ * transform size. It is never modified by the transform functions, so a single
+ * plan can be shared by several threads.
+ */
+typedef struct FFTPlan FFTPlan;
+
+/**
+ * @brief Creates a real FFT plan.
+ *
+ * @param size Transform size (power of two, at least 2)
+ * @return Pointer to the created FFTPlan, or NULL on failure
+ */
+FFTPlan *create_fft_plan(int size);
+
+/**
+ * @brief Returns the transform size of a FFT plan.
+ *
+ * @param plan Pointer to the FFT plan
+ * @return Transform size in samples
+ */
+int fft_plan_size(const FFTPlan *plan);
+
+/**
+ * @brief Returns the smallest supported transform size that is not less than n.
+ *
+ * @param n Requested minimum size
+ * @return Power of two greater than or equal to n (at least 2)
+ */
+int fft_next_size(int n);
+
+/**
+ * @brief Computes the forward transform of a real signal.
+ *
+ * The spectrum holds the size/2 + 1 non-redundant bins as interleaved
+ * (real, imaginary) pairs, i.e. size + 2 floats.
+ *
+ * @param plan Pointer to the FFT plan
+ * @param input Pointer to the input signal (size samples)
+ * @param spectrum Pointer to the output spectrum (size + 2 floats)
+ */
+void fft_forward(const FFTPlan *plan, const float *input, float *spectrum);
+
+/**
+ * @brief Computes the normalized inverse transform back to a real signal.
+ *
+ * @param plan Pointer to the FFT plan
+ * @param spectrum Pointer to the input spectrum (size + 2 floats)
+ * @param output Pointer to the output signal (size samples)
+ */
+void fft_inverse(const FFTPlan *plan, const float *spectrum, float *output);
+
+/**
+ * @brief Multiplies two spectra bin by bin and adds the result to an accumulator.
+ *
+ * @param a Pointer to the first spectrum
+ * @param b Pointer to the second spectrum
+ * @param accumulator Pointer to the accumulated spectrum
+ * @param bins Number of complex bins (size/2 + 1 for a full spectrum)
+ */
+void fft_multiply_accumulate(const float *a, const float *b, float *accumulator, int bins);
+
+/**
+ * @brief Destroys a FFT plan.
+ *
+ * @param plan Pointer to the FFT plan to be destroyed
+ */
+void destroy_fft_plan(FFTPlan *plan);
+
+
+#endif // FFT_H
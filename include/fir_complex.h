@@ -0,0 +1,122 @@
+#ifndef FIR_COMPLEX_H
+#define FIR_COMPLEX_H
+
+#include "fir_filter.h"
+#include "fir_filter_simd.h"
+
+
+/**
+ * @brief Struct for a FIR filter with complex coefficients.
+ */
+typedef struct {
+    int kernel_length;      /**< Length of the filter kernel (complex taps) */
+    float *coefficients;    /**< Interleaved complex coefficients: re[0], im[0], re[1], im[1], ... */
+} FIRFilterComplex;
+
+/**
+ * @brief Applies a real FIR filter to an interleaved complex (I/Q) signal.
+ *
+ * The signal is stored as I[0], Q[0], I[1], Q[1], ..., and the output has the same layout.
+ * Every coefficient is broadcast once per block and serves both components of the vectors of samples.
+ * The I and Q outputs equal apply_fir_filter_simd_level at the same level on the separated components.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the interleaved complex input signal (2 * signal_length floats)
+ * @param output_signal Pointer to the interleaved complex output signal (2 * signal_length floats)
+ * @param signal_length Number of complex samples
+ */
+void apply_fir_filter_complex(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies a real FIR filter to an interleaved complex signal using the kernel of a given level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the interleaved complex input signal (2 * signal_length floats)
+ * @param output_signal Pointer to the interleaved complex output signal (2 * signal_length floats)
+ * @param signal_length Number of complex samples
+ */
+void apply_fir_filter_complex_level(
+        FIRSimdLevel level,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Creates a FIR filter with complex coefficients.
+ *
+ * @param coefficients Pointer to the interleaved complex coefficients (2 * kernel_length floats), copied
+ * @param kernel_length Number of complex taps
+ * @return Pointer to the created FIRFilterComplex, or NULL on failure
+ */
+FIRFilterComplex *create_fir_filter_complex(const float *coefficients, int kernel_length);
+
+/**
+ * @brief Creates a complex band-pass filter by shifting a real low-pass prototype to a center frequency.
+ *
+ * The taps are h[n] * exp(i * 2 * pi * center_freq * (n - (kernel_length - 1) / 2) / sample_rate), so the pass band
+ * of the prototype moves to center_freq (negative frequencies select the lower side of the spectrum)
+ * and the phase is zero at the center tap. This selects one channel of an I/Q capture in a single pass.
+ *
+ * @param prototype Pointer to the real prototype filter (normally a low-pass filter)
+ * @param center_freq Center frequency in Hz, in (-sample_rate / 2, sample_rate / 2)
+ * @return Pointer to the created FIRFilterComplex, or NULL on failure
+ */
+FIRFilterComplex *shift_fir_filter_complex(const FIRFilter *prototype, float center_freq);
+
+/**
+ * @brief Applies a complex FIR filter to an interleaved complex (I/Q) signal.
+ *
+ * Every output is y[i] = sum_j h[j] * x[i - j] in complex arithmetic. The real and imaginary parts of the taps
+ * are broadcast once per block and multiplied with vectors of whole complex samples, and the two partial sums
+ * are combined with one add-subtract per output vector at the end.
+ *
+ * @param filter Pointer to the complex FIR filter
+ * @param input_signal Pointer to the interleaved complex input signal (2 * signal_length floats)
+ * @param output_signal Pointer to the interleaved complex output signal (2 * signal_length floats)
+ * @param signal_length Number of complex samples
+ */
+void apply_fir_filter_complex_taps(
+        const FIRFilterComplex *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies a complex FIR filter to an interleaved complex signal using the kernel of a given level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the complex FIR filter
+ * @param input_signal Pointer to the interleaved complex input signal (2 * signal_length floats)
+ * @param output_signal Pointer to the interleaved complex output signal (2 * signal_length floats)
+ * @param signal_length Number of complex samples
+ */
+void apply_fir_filter_complex_taps_level(
+        FIRSimdLevel level,
+        const FIRFilterComplex *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a complex FIR filter.
+ *
+ * @param filter Pointer to the complex FIR filter to be destroyed
+ */
+void destroy_fir_filter_complex(FIRFilterComplex *filter);
+
+
+#endif // FIR_COMPLEX_H
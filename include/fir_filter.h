@@ -2,12 +2,19 @@
 #define FIR_FILTER_H
 
 
+/**
+ * @brief Largest magnitude of a structural zero tap of a half-band filter, relative to the center tap.
+ */
+#define HALF_BAND_TOLERANCE 1e-6f
+
 /**
  * @brief Enum for filter types.
  */
 typedef enum {
     LOW_PASS,  /**< Low-pass filter */
-    HIGH_PASS  /**< High-pass filter */
+    HIGH_PASS, /**< High-pass filter */
+    BAND_PASS, /**< Band-pass filter between cutoff_freq and cutoff_freq_high */
+    BAND_STOP  /**< Band-stop filter between cutoff_freq and cutoff_freq_high */
 } FilterType;
 
 /**
@@ -20,7 +27,9 @@ typedef enum {
     BLACKMAN,     /**< Blackman window */
     KAISER_B6,    /**< Kaiser window with beta=6 */
     KAISER_B8,    /**< Kaiser window with beta=8 */
-    KAISER_B10    /**< Kaiser window with beta=10 */
+    KAISER_B10,   /**< Kaiser window with beta=10 */
+    KAISER,       /**< Kaiser window with the beta of the filter (see create_fir_filter_kaiser) */
+    REMEZ         /**< No window, equiripple design by the Remez exchange (see create_fir_filter_remez) */
 } WindowType;
 
 /**
@@ -29,10 +38,14 @@ typedef enum {
 typedef struct {
     FilterType type;        /**< Type of filter */
     WindowType window;      /**< Type of window */
-    float cutoff_freq;      /**< Cutoff frequency in Hz */
+    float cutoff_freq;      /**< Cutoff frequency in Hz (the lower edge of a band filter) */
     int kernel_length;      /**< Length of the filter kernel */
     float sample_rate;      /**< Sampling rate in Hz */
     float *coefficients;    /**< Filter coefficients */
+    int is_symmetric;       /**< Non-zero if the coefficients are exactly symmetric (linear phase) */
+    int is_half_band;       /**< Non-zero if every other tap, counted from the center, is (near) zero */
+    float kaiser_beta;      /**< Beta parameter of a Kaiser window, zero for the other windows */
+    float cutoff_freq_high; /**< Upper edge of a band filter in Hz, zero for low-pass and high-pass filters */
 } FIRFilter;
 
 /**
@@ -53,6 +66,76 @@ FIRFilter *create_fir_filter(
         float sample_rate
 );
 
+/**
+ * @brief Creates a band-pass or band-stop FIR filter as a single kernel.
+ *
+ * The band-pass filter is the difference of the windowed sinc low-pass filters at the two edges,
+ * and the band-stop filter is its spectral inversion, so a band costs one convolution instead of
+ * a cascade of a low-pass and a high-pass filter.
+ *
+ * @param type Type of filter (BAND_PASS or BAND_STOP)
+ * @param window Type of window
+ * @param cutoff_freq_low Lower edge of the band in Hz
+ * @param cutoff_freq_high Upper edge of the band in Hz
+ * @param kernel_length Length of the filter kernel
+ * @param sample_rate Sampling rate in Hz
+ * @return Pointer to the created FIRFilter, or NULL on failure
+ */
+FIRFilter *create_fir_filter_band(
+        FilterType type,
+        WindowType window,
+        float cutoff_freq_low,
+        float cutoff_freq_high,
+        int kernel_length,
+        float sample_rate
+);
+
+/**
+ * @brief Returns the beta parameter of a Kaiser window for a stop band attenuation (Kaiser's formula).
+ *
+ * beta = 0.1102 * (A - 8.7) for A > 50 dB, 0.5842 * (A - 21)^0.4 + 0.07886 * (A - 21) for 21 dB <= A <= 50 dB,
+ * and 0 (rectangular window) below 21 dB.
+ *
+ * @param attenuation_db Stop band attenuation A in dB
+ * @return Beta parameter of the Kaiser window
+ */
+float fir_kaiser_beta(float attenuation_db);
+
+/**
+ * @brief Returns the minimum odd kernel length of a Kaiser windowed filter for a stop band attenuation
+ * and a transition width (Kaiser's formula).
+ *
+ * kernel_length = (A - 8) / (2.285 * 2 * pi * transition_width / sample_rate) + 1, rounded up to an odd integer.
+ *
+ * @param attenuation_db Stop band attenuation A in dB
+ * @param transition_width Width of the transition band in Hz
+ * @param sample_rate Sampling rate in Hz
+ * @return Kernel length, or 0 on invalid parameters
+ */
+int fir_kaiser_kernel_length(float attenuation_db, float transition_width, float sample_rate);
+
+/**
+ * @brief Creates a FIR filter with a Kaiser window from a stop band attenuation and transition width specification.
+ *
+ * The beta parameter and the shortest kernel length which meet the specification are calculated with
+ * fir_kaiser_beta and fir_kaiser_kernel_length, and the filter is designed like create_fir_filter with
+ * the window type KAISER. The transition band is centered at the cutoff frequency.
+ *
+ * @param type Type of filter
+ * @param cutoff_freq Cutoff frequency in Hz (center of the transition band)
+ * @param attenuation_db Stop band attenuation in dB
+ * @param transition_width Width of the transition band in Hz
+ * @param sample_rate Sampling rate in Hz
+ * @return Pointer to the created FIRFilter, or NULL on failure
+ */
+FIRFilter *create_fir_filter_kaiser(
+        FilterType type,
+        float cutoff_freq,
+        float attenuation_db,
+        float transition_width,
+        float sample_rate
+);
+
 /**
  * @brief Applies the FIR filter to an input signal.
  *
@@ -68,6 +151,31 @@ void apply_fir_filter(
         int signal_length
 );
 
+/**
+ * @brief Detects the structure of the filter coefficients and records it in the filter.
+ *
+ * Sets is_symmetric if h[n] == h[kernel_length - 1 - n] holds exactly for every n, which is the case
+ * for every filter designed by create_fir_filter. Sets is_half_band if the filter is symmetric with an odd
+ * length and every tap at an even, non-zero distance from the center tap is at most HALF_BAND_TOLERANCE
+ * times the center tap, which is the case for filters with cutoff_freq == sample_rate / 4.
+ * The vectorized apply engines use the recorded structure to choose their fast paths, so this function
+ * has to be called again after the coefficients are modified or loaded from elsewhere.
+ *
+ * @param filter Pointer to the FIR filter
+ */
+void detect_fir_filter_structure(FIRFilter *filter);
+
+/**
+ * @brief Sets the structural zero taps of a half-band filter to exactly zero.
+ *
+ * The windowed sinc of a half-band filter has rounding residues instead of exact zeros, which the
+ * half-band fast path skips. Zeroing them makes every apply engine compute exactly the same filter.
+ * Filters which are not half-band (is_half_band == 0) are left unchanged.
+ *
+ * @param filter Pointer to the FIR filter
+ */
+void zero_fir_filter_half_band_taps(FIRFilter *filter);
+
 /**
  * @brief Destroys a FIR filter.
  *
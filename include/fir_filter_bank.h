@@ -0,0 +1,78 @@
+#ifndef FIR_FILTER_BANK_H
+#define FIR_FILTER_BANK_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Shortest kernel for which FIR_BANK_AUTO selects the shared FFT.
+ */
+#define FIR_BANK_FFT_MIN_LENGTH 512
+
+/**
+ * @brief Enum for the convolution methods of a filter bank.
+ */
+typedef enum {
+    FIR_BANK_AUTO,      /**< Shared FFT if the kernels are long and of similar length, direct form otherwise */
+    FIR_BANK_DIRECT,    /**< Vectorized direct form, all filters applied block by block */
+    FIR_BANK_FFT        /**< Overlap-save with one shared transform of every input block */
+} FIRBankMethod;
+
+/**
+ * @brief Opaque bank of FIR filters which are applied to the same input signal in one pass.
+ *
+ * The input is processed in cache-sized blocks and every block is filtered by all filters
+ * before moving on, so the input is streamed from memory once instead of once per filter.
+ */
+typedef struct FIRFilterBank FIRFilterBank;
+
+/**
+ * @brief Creates a filter bank.
+ *
+ * The filter coefficients are copied into the bank, so the filters may be destroyed or modified afterwards.
+ * With FIR_BANK_FFT every input block is transformed once and multiplied with the spectra of all filters,
+ * the transform length being chosen for the longest kernel. FIR_BANK_AUTO selects it when every kernel has
+ * at least FIR_BANK_FFT_MIN_LENGTH taps and the longest kernel is at most twice as long as the shortest.
+ *
+ * @param filters Array of pointers to the FIR filters
+ * @param filter_count Number of filters
+ * @param method Convolution method
+ * @return Pointer to the created FIRFilterBank, or NULL on failure
+ */
+FIRFilterBank *create_fir_filter_bank(FIRFilter *const *filters, int filter_count, FIRBankMethod method);
+
+/**
+ * @brief Returns the convolution method used by a filter bank (never FIR_BANK_AUTO).
+ *
+ * @param bank Pointer to the filter bank
+ * @return FIR_BANK_DIRECT or FIR_BANK_FFT
+ */
+FIRBankMethod fir_filter_bank_method(const FIRFilterBank *bank);
+
+/**
+ * @brief Applies all filters of a bank to an input signal.
+ *
+ * With FIR_BANK_DIRECT, output k is the same as the output of apply_fir_filter_simd with filter k.
+ * With FIR_BANK_FFT, it is the same as the output of apply_fir_filter up to the rounding error of the transforms.
+ *
+ * @param bank Pointer to the filter bank
+ * @param input_signal Pointer to the input signal array
+ * @param output_signals Array of filter_count pointers to the output signal arrays, in the order of the filters
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_bank(
+        FIRFilterBank *bank,
+        const float *input_signal,
+        float *const *output_signals,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a filter bank.
+ *
+ * @param bank Pointer to the filter bank to be destroyed
+ */
+void destroy_fir_filter_bank(FIRFilterBank *bank);
+
+
+#endif // FIR_FILTER_BANK_H
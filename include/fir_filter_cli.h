@@ -23,6 +23,18 @@ void print_usage(const char *prog_name);
  */
 void handle_create_fir_filter(int argc, char *argv[]);
 
+/**
+ * @brief Handles the creation of a Kaiser window FIR filter from a specification.
+ *
+ * This function parses the command-line arguments to create the shortest FIR filter
+ * with a Kaiser window which meets the stop band attenuation and transition width,
+ * prints the chosen beta and kernel length and saves the filter to a binary file.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_create_kaiser_fir_filter(int argc, char *argv[]);
+
 /**
  * @brief Handles the application of a FIR filter to an input signal.
  *
@@ -35,6 +47,67 @@ void handle_create_fir_filter(int argc, char *argv[]);
  */
 void handle_apply_fir_filter(int argc, char *argv[]);
 
+/**
+ * @brief Handles the decimation of an input signal with a FIR filter.
+ *
+ * This function reads an input signal from a file, filters it with a previously
+ * created FIR filter loaded from a binary file while keeping only every factor-th
+ * output sample, and writes the decimated output signal to another file.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_decimate_fir_filter(int argc, char *argv[]);
+
+/**
+ * @brief Handles the interpolation of an input signal with a FIR filter.
+ *
+ * This function reads an input signal from a file, upsamples it by the given factor
+ * while filtering it with a previously created FIR filter loaded from a binary file
+ * (scaled by the factor to keep the amplitude), and writes the interpolated output
+ * signal to another file.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_interpolate_fir_filter(int argc, char *argv[]);
+
+/**
+ * @brief Handles the rational resampling of an input signal.
+ *
+ * This function reads an input signal from a file, changes its sample rate by
+ * up_factor / down_factor with a polyphase resampler whose anti-aliasing filter
+ * uses the given window type, and writes the resampled signal to another file.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_resample_signal(int argc, char *argv[]);
+
+/**
+ * @brief Handles the application of a FIR filter in Q15 fixed point.
+ *
+ * This function reads a raw int16 input signal from a file, quantizes the filter
+ * from the filter file to Q15, filters the signal with integer arithmetic and
+ * writes the raw int16 output signal to another file.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_apply_q15_fir_filter(int argc, char *argv[]);
+
+/**
+ * @brief Handles the calibration of the engine planner.
+ *
+ * This function times the convolution engines on the running machine and saves the results
+ * to a wisdom file (by default FIR_DEFAULT_WISDOM_FILE, or the FIR_FILTER_WISDOM environment variable),
+ * which later apply commands load to pick the fastest engine.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ */
+void handle_calibrate_planner(int argc, char *argv[]);
+
 /**
  * @brief Handles the destruction of a FIR filter.
  *
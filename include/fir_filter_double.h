@@ -0,0 +1,99 @@
+#ifndef FIR_FILTER_DOUBLE_H
+#define FIR_FILTER_DOUBLE_H
+
+#include "fir_filter.h"
+#include "fir_filter_simd.h"
+
+
+/**
+ * @brief Struct for a FIR filter designed and applied in double precision.
+ */
+typedef struct {
+    FilterType type;        /**< Type of filter */
+    WindowType window;      /**< Type of window */
+    double cutoff_freq;     /**< Cutoff frequency in Hz */
+    int kernel_length;      /**< Length of the filter kernel */
+    double sample_rate;     /**< Sampling rate in Hz */
+    double *coefficients;   /**< Filter coefficients */
+    int is_symmetric;       /**< Non-zero if the coefficients are exactly symmetric (linear phase) */
+} FIRFilterDouble;
+
+/**
+ * @brief Creates a FIR filter with the windowed-sinc design of create_fir_filter in double precision.
+ *
+ * The sinc, the windows and the Bessel function of the Kaiser windows are evaluated in double,
+ * which keeps the stop band of very long, narrow filters clean where the float design is limited
+ * by the rounding of the sinc argument and of the window terms.
+ *
+ * @param type Type of filter
+ * @param window Type of window
+ * @param cutoff_freq Cutoff frequency in Hz
+ * @param kernel_length Length of the filter kernel (made odd like in create_fir_filter)
+ * @param sample_rate Sampling rate in Hz
+ * @return Pointer to the created FIRFilterDouble, or NULL on failure
+ */
+FIRFilterDouble *create_fir_filter_double(
+        FilterType type,
+        WindowType window,
+        double cutoff_freq,
+        int kernel_length,
+        double sample_rate
+);
+
+/**
+ * @brief Creates a float FIR filter from a double-precision design, with every coefficient rounded once.
+ *
+ * The float filter works with every float engine and the filter file format.
+ *
+ * @param filter Pointer to the double-precision FIR filter
+ * @return Pointer to the created FIRFilter, or NULL on failure
+ */
+FIRFilter *convert_fir_filter_double_to_float(const FIRFilterDouble *filter);
+
+/**
+ * @brief Applies a double-precision FIR filter to a double input signal.
+ *
+ * Symmetric filters are folded like in apply_fir_filter_simd, and the outputs are accumulated
+ * in double by the AVX2 + FMA or AVX-512 kernels on CPUs which have them.
+ *
+ * @param filter Pointer to the double-precision FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_double(
+        const FIRFilterDouble *filter,
+        const double *input_signal,
+        double *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies a double-precision FIR filter using the kernel of a given instruction set level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ * The SSE4.1 level uses the scalar kernel.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the double-precision FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_double_level(
+        FIRSimdLevel level,
+        const FIRFilterDouble *filter,
+        const double *input_signal,
+        double *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a double-precision FIR filter.
+ *
+ * @param filter Pointer to the double-precision FIR filter to be destroyed
+ */
+void destroy_fir_filter_double(FIRFilterDouble *filter);
+
+
+#endif // FIR_FILTER_DOUBLE_H
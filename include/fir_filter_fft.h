@@ -0,0 +1,79 @@
+#ifndef FIR_FILTER_FFT_H
+#define FIR_FILTER_FFT_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Applies the FIR filter to an input signal using FFT overlap-add convolution.
+ *
+ * The output is the same as the output of apply_fir_filter (the convolution truncated
+ * to the length of the input signal), up to the rounding error of the transforms.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_fft(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Opaque overlap-save convolution plan with a precomputed kernel spectrum.
+ *
+ * The plan keeps the spectrum of the filter kernel, so each block of a signal only costs
+ * one forward and one inverse transform. The plan holds its own work buffers, so it must
+ * not be used by several threads at the same time.
+ */
+typedef struct FIRFFTPlan FIRFFTPlan;
+
+/**
+ * @brief Creates an overlap-save convolution plan for a FIR filter.
+ *
+ * The filter coefficients are copied into the plan in the frequency domain,
+ * so the filter may be destroyed or modified afterwards.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param block_length Number of output samples per transform, or 0 to choose it from the kernel length
+ * @return Pointer to the created FIRFFTPlan, or NULL on failure
+ */
+FIRFFTPlan *create_fir_fft_plan(const FIRFilter *filter, int block_length);
+
+/**
+ * @brief Returns the number of output samples computed per transform by the plan.
+ *
+ * @param plan Pointer to the overlap-save plan
+ * @return Block length in samples
+ */
+int fir_fft_plan_block_length(const FIRFFTPlan *plan);
+
+/**
+ * @brief Applies a precomputed overlap-save plan to an input signal.
+ *
+ * Every call treats the signal as starting from silence, like apply_fir_filter.
+ *
+ * @param plan Pointer to the overlap-save plan
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_fft_plan(
+        FIRFFTPlan *plan,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys an overlap-save convolution plan.
+ *
+ * @param plan Pointer to the plan to be destroyed
+ */
+void destroy_fir_fft_plan(FIRFFTPlan *plan);
+
+
+#endif // FIR_FILTER_FFT_H
@@ -0,0 +1,75 @@
+#ifndef FIR_FILTER_SIMD_H
+#define FIR_FILTER_SIMD_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Enum for the instruction set levels of the vectorized kernels.
+ */
+typedef enum {
+    FIR_SIMD_SCALAR,    /**< Portable scalar kernel */
+    FIR_SIMD_SSE41,     /**< SSE4.1 kernel, 4 outputs per vector */
+    FIR_SIMD_AVX2,      /**< AVX2 + FMA kernel, 8 outputs per vector */
+    FIR_SIMD_AVX512     /**< AVX-512F kernel, 16 outputs per vector */
+} FIRSimdLevel;
+
+/**
+ * @brief Detects the best instruction set level supported by the running CPU.
+ *
+ * The detection (cpuid) runs once, later calls return the cached result.
+ *
+ * @return Best supported FIRSimdLevel
+ */
+FIRSimdLevel fir_simd_detect(void);
+
+/**
+ * @brief Returns a printable name of an instruction set level.
+ *
+ * @param level Instruction set level
+ * @return Name of the level, e.g. "avx2"
+ */
+const char *fir_simd_level_name(FIRSimdLevel level);
+
+/**
+ * @brief Applies the FIR filter to an input signal using the best vectorized kernel for the running CPU.
+ *
+ * Filters with symmetric coefficients (is_symmetric, see detect_fir_filter_structure) are applied
+ * with a folded kernel, which adds the mirrored input samples before multiplying and so needs half
+ * of the multiplications. The output is the same as the output of apply_fir_filter, up to the rounding
+ * differences of the folding and of the fused multiply-add instructions.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_simd(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies the FIR filter to an input signal using the vectorized kernel of a given level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ * Symmetric filters are folded as in apply_fir_filter_simd.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_simd_level(
+        FIRSimdLevel level,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+
+#endif // FIR_FILTER_SIMD_H
@@ -0,0 +1,78 @@
+#ifndef FIR_FIXED_POINT_H
+#define FIR_FIXED_POINT_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fir_filter_simd.h"
+
+
+/**
+ * @brief Structure for a FIR filter with Q15 fixed-point coefficients.
+ */
+typedef struct {
+    int kernel_length;          /**< Length of the filter kernel */
+    int16_t *coefficients;      /**< Q15 coefficients, h[j] * 32768 rounded and saturated to [-32767, 32767] */
+    int64_t absolute_sum;       /**< Sum of the absolute Q15 coefficients */
+    int16_t *reversed_coefficients; /**< Q15 coefficients in reversed order, zero-padded in front to padded_length */
+    int padded_length;          /**< Kernel length rounded up to the widest vector of the kernels (32 taps) */
+} FIRFilterQ15;
+
+/**
+ * @brief Quantizes the coefficients of a FIR filter to Q15.
+ *
+ * Every coefficient is rounded to the nearest multiple of 2^-15 and saturated to the symmetric range
+ * [-1 + 2^-15, 1 - 2^-15], so that a pair of products always fits in 32 bits.
+ *
+ * @param filter Pointer to the FIR filter
+ * @return Pointer to the created FIRFilterQ15, or NULL on failure
+ */
+FIRFilterQ15 *quantize_fir_filter_q15(const FIRFilter *filter);
+
+/**
+ * @brief Applies a Q15 FIR filter to an int16 input signal.
+ *
+ * The products of the Q15 coefficients and the samples are summed exactly in a 32-bit accumulator when
+ * the absolute coefficient sum shows that it cannot overflow (sum of |h| below 2), and in a 64-bit accumulator
+ * otherwise, into which the vectorized kernels widen every pair of products. Every output is rounded to the nearest integer from the Q30 sum and saturated to the int16 range.
+ * The vectorized kernels (pmaddwd) give the same output as the scalar kernel, as the sums are exact.
+ *
+ * @param filter Pointer to the Q15 FIR filter
+ * @param input_signal Pointer to the int16 input signal array
+ * @param output_signal Pointer to the int16 output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_q15(
+        const FIRFilterQ15 *filter,
+        const int16_t *input_signal,
+        int16_t *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies a Q15 FIR filter to an int16 input signal using the kernel of a given instruction set level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the Q15 FIR filter
+ * @param input_signal Pointer to the int16 input signal array
+ * @param output_signal Pointer to the int16 output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_q15_level(
+        FIRSimdLevel level,
+        const FIRFilterQ15 *filter,
+        const int16_t *input_signal,
+        int16_t *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a Q15 FIR filter.
+ *
+ * @param filter Pointer to the Q15 FIR filter to be destroyed
+ */
+void destroy_fir_filter_q15(FIRFilterQ15 *filter);
+
+
+#endif // FIR_FIXED_POINT_H
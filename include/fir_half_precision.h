@@ -0,0 +1,106 @@
+#ifndef FIR_HALF_PRECISION_H
+#define FIR_HALF_PRECISION_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fir_filter_simd.h"
+
+
+/**
+ * @brief 16-bit floating-point storage formats.
+ */
+typedef enum {
+    FIR_HALF_FP16,      /**< IEEE 754 binary16: 5 exponent bits, 10 mantissa bits (about 3 decimal digits) */
+    FIR_HALF_BF16       /**< bfloat16: the upper half of a float, 8 exponent bits, 7 mantissa bits */
+} FIRHalfFormat;
+
+/**
+ * @brief Structure for a FIR filter with 16-bit floating-point coefficients.
+ */
+typedef struct {
+    FIRHalfFormat format;       /**< Storage format of the coefficients and of the signals filtered with them */
+    int kernel_length;          /**< Length of the filter kernel */
+    uint16_t *coefficients;     /**< Filter coefficients in the storage format */
+} FIRFilterHalf;
+
+/**
+ * @brief Converts floats to a 16-bit storage format, rounding to nearest even.
+ *
+ * FP16 overflows to infinity and keeps subnormals. BF16 flushes subnormal floats to zero,
+ * as the AVX-512 BF16 conversion instruction does, so every CPU produces the same bits.
+ * F16C and AVX-512 BF16 instructions are used when the running CPU has them.
+ *
+ * @param format Storage format
+ * @param input Pointer to the float array
+ * @param output Pointer to the 16-bit array
+ * @param length Number of values
+ */
+void fir_float_to_half(FIRHalfFormat format, const float *input, uint16_t *output, int length);
+
+/**
+ * @brief Widens values of a 16-bit storage format to floats (exact).
+ *
+ * @param format Storage format
+ * @param input Pointer to the 16-bit array
+ * @param output Pointer to the float array
+ * @param length Number of values
+ */
+void fir_half_to_float(FIRHalfFormat format, const uint16_t *input, float *output, int length);
+
+/**
+ * @brief Converts the coefficients of a FIR filter to a 16-bit storage format.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param format Storage format
+ * @return Pointer to the created FIRFilterHalf, or NULL on failure
+ */
+FIRFilterHalf *convert_fir_filter_half(const FIRFilter *filter, FIRHalfFormat format);
+
+/**
+ * @brief Applies a 16-bit FIR filter to a signal stored in the same format.
+ *
+ * The signal is widened to FP32 block by block in a cache-resident buffer, filtered by the vectorized
+ * kernels of apply_fir_filter_simd with FP32 accumulation, and rounded back to the storage format.
+ * Every output equals the output of apply_fir_filter_simd on the widened filter and signal, rounded once,
+ * while the signals in memory take half the bytes of float signals.
+ *
+ * @param filter Pointer to the 16-bit FIR filter
+ * @param input_signal Pointer to the input signal array in the storage format of the filter
+ * @param output_signal Pointer to the output signal array in the storage format of the filter
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_half(
+        const FIRFilterHalf *filter,
+        const uint16_t *input_signal,
+        uint16_t *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies a 16-bit FIR filter using the kernel of a given instruction set level.
+ *
+ * A level which is not supported by the running CPU falls back to the best supported level below it.
+ *
+ * @param level Instruction set level of the kernel
+ * @param filter Pointer to the 16-bit FIR filter
+ * @param input_signal Pointer to the input signal array in the storage format of the filter
+ * @param output_signal Pointer to the output signal array in the storage format of the filter
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_half_level(
+        FIRSimdLevel level,
+        const FIRFilterHalf *filter,
+        const uint16_t *input_signal,
+        uint16_t *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a 16-bit FIR filter.
+ *
+ * @param filter Pointer to the 16-bit FIR filter to be destroyed
+ */
+void destroy_fir_filter_half(FIRFilterHalf *filter);
+
+
+#endif // FIR_HALF_PRECISION_H
@@ -0,0 +1,30 @@
+#ifndef FIR_MIN_PHASE_H
+#define FIR_MIN_PHASE_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Creates the minimum-phase equivalent of a FIR filter, with the same magnitude response.
+ *
+ * A linear-phase filter delays every frequency by (kernel_length - 1) / 2 samples. The minimum-phase filter
+ * with the same magnitude response has the smallest possible delay, with its energy concentrated in the first
+ * taps, so it can also be truncated to fewer taps for latency-critical processing. The filter is computed
+ * with the cepstral (homomorphic) method: the real cepstrum of the log magnitude response is folded onto its
+ * causal part and transformed back with the complex exponential, on an FFT grid 64 times the kernel length
+ * (less for filters longer than 262144 taps).
+ * Magnitudes more than 200 dB below the peak are raised to that level, so the zeros of the stop band do not
+ * make the logarithm diverge.
+ *
+ * The converted filter keeps the type, window, cutoff frequency and sample rate of the original filter
+ * as the description of its design, but it is not symmetric.
+ *
+ * @param filter Pointer to the FIR filter (normally a linear-phase filter from create_fir_filter)
+ * @param kernel_length Length of the minimum-phase filter, at most filter->kernel_length,
+ *                      or 0 for the length of the original filter
+ * @return Pointer to the created FIRFilter, or NULL on failure
+ */
+FIRFilter *convert_fir_filter_minimum_phase(const FIRFilter *filter, int kernel_length);
+
+
+#endif // FIR_MIN_PHASE_H
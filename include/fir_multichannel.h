@@ -0,0 +1,41 @@
+#ifndef FIR_MULTICHANNEL_H
+#define FIR_MULTICHANNEL_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Enum for the memory layouts of multi-channel signals.
+ */
+typedef enum {
+    FIR_LAYOUT_INTERLEAVED, /**< Frame after frame, sample (frame, channel) at frame * channel_count + channel */
+    FIR_LAYOUT_PLANAR       /**< Channel after channel, sample (frame, channel) at channel * frame_count + frame */
+} FIRChannelLayout;
+
+/**
+ * @brief Applies the same FIR filter to every channel of a multi-channel signal.
+ *
+ * Interleaved signals are vectorized across the channels: every coefficient is broadcast once per frame
+ * and multiplied with the samples of all channels, so its load is shared by the whole frame.
+ * Planar signals are filtered channel by channel with apply_fir_filter_simd, with the kernel staying in cache.
+ * Every channel of the output is the same as the output of apply_fir_filter for that channel,
+ * up to the rounding differences of the fused multiply-add instructions.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array (frame_count * channel_count samples)
+ * @param output_signal Pointer to the output signal array, in the same layout as the input
+ * @param frame_count Number of samples per channel
+ * @param channel_count Number of channels
+ * @param layout Memory layout of the input and output signals
+ */
+void apply_fir_filter_multichannel(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int frame_count,
+        int channel_count,
+        FIRChannelLayout layout
+);
+
+
+#endif // FIR_MULTICHANNEL_H
@@ -0,0 +1,135 @@
+#ifndef FIR_MULTIRATE_H
+#define FIR_MULTIRATE_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Returns the number of output samples of a decimation.
+ *
+ * @param signal_length Length of the input signal
+ * @param factor Decimation factor
+ * @return Number of output samples, ceil(signal_length / factor)
+ */
+int fir_decimated_length(int signal_length, int factor);
+
+/**
+ * @brief Filters and downsamples an input signal in one pass (polyphase decimation).
+ *
+ * The output equals the output of apply_fir_filter with only every factor-th sample kept
+ * (samples 0, factor, 2 * factor, ...) up to float rounding, but only the kept samples are calculated.
+ * The products are summed phase by phase, in a different order than in apply_fir_filter.
+ *
+ * @param filter Pointer to the FIR filter (normally a low-pass filter with cutoff below sample_rate / (2 * factor))
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array (fir_decimated_length(signal_length, factor) samples)
+ * @param signal_length Length of the input signal
+ * @param factor Decimation factor
+ * @return 0 on success, or -1 on invalid parameters or failed memory allocation
+ */
+int apply_fir_decimate(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int factor
+);
+
+/**
+ * @brief Upsamples and filters an input signal in one pass (polyphase interpolation).
+ *
+ * The output is the output of apply_fir_filter over the input with factor - 1 zeros stuffed after
+ * every sample (signal_length * factor samples), but the zero multiplications are never performed:
+ * every output sample costs kernel_length / factor multiplications. Zero stuffing scales the passband
+ * by 1 / factor, so the output has to be multiplied by factor to keep the amplitude of the input.
+ *
+ * @param filter Pointer to the FIR filter (normally a low-pass filter with cutoff below sample_rate / (2 * factor))
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array (signal_length * factor samples)
+ * @param signal_length Length of the input signal
+ * @param factor Interpolation factor
+ * @return 0 on success, or -1 on invalid parameters or failed memory allocation
+ */
+int apply_fir_interpolate(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int factor
+);
+
+/**
+ * @brief Opaque streaming rational resampler (polyphase, up_factor / down_factor).
+ *
+ * The resampler keeps its input history and output phase between calls, so a stream
+ * can be resampled in chunks of any size.
+ */
+typedef struct FIRResampler FIRResampler;
+
+/**
+ * @brief Creates a rational resampler which changes the sample rate by up_factor / down_factor.
+ *
+ * The anti-aliasing (and anti-imaging) filter is a windowed-sinc low-pass filter designed by create_fir_filter
+ * at the intermediate rate, with the cutoff at the lower of the two Nyquist frequencies and a gain of up_factor.
+ * The factors are reduced by their greatest common divisor, e.g. 48000 / 44100 becomes 160 / 147.
+ *
+ * @param up_factor Interpolation factor L (e.g. the output sample rate)
+ * @param down_factor Decimation factor M (e.g. the input sample rate)
+ * @param window Type of window of the anti-aliasing filter
+ * @param kernel_length Length of the anti-aliasing filter at the intermediate rate, or 0 for 32 taps per phase
+ * @return Pointer to the created FIRResampler, or NULL on failure
+ */
+FIRResampler *create_fir_resampler(int up_factor, int down_factor, WindowType window, int kernel_length);
+
+/**
+ * @brief Returns the anti-aliasing filter of a resampler (at the intermediate rate, including the gain).
+ *
+ * @param resampler Pointer to the resampler
+ * @return Pointer to the filter owned by the resampler
+ */
+const FIRFilter *fir_resampler_filter(const FIRResampler *resampler);
+
+/**
+ * @brief Returns the largest number of output samples that the next call with input_length samples can produce.
+ *
+ * @param resampler Pointer to the resampler
+ * @param input_length Number of input samples
+ * @return Upper bound for the number of output samples
+ */
+int fir_resampler_max_output_length(const FIRResampler *resampler, int input_length);
+
+/**
+ * @brief Resamples the next samples of a stream.
+ *
+ * The concatenated output of consecutive calls equals every down_factor-th sample of the filtered,
+ * up_factor times zero-stuffed concatenated input.
+ *
+ * @param resampler Pointer to the resampler
+ * @param input_signal Pointer to the next input samples
+ * @param input_length Number of input samples
+ * @param output_signal Pointer to the output samples (fir_resampler_max_output_length samples)
+ * @return Number of output samples produced, or -1 on invalid parameters
+ */
+int process_fir_resampler(
+        FIRResampler *resampler,
+        const float *input_signal,
+        int input_length,
+        float *output_signal
+);
+
+/**
+ * @brief Resets a resampler to the start of a new stream (silent history, output phase zero).
+ *
+ * @param resampler Pointer to the resampler
+ */
+void reset_fir_resampler(FIRResampler *resampler);
+
+/**
+ * @brief Destroys a resampler.
+ *
+ * @param resampler Pointer to the resampler to be destroyed
+ */
+void destroy_fir_resampler(FIRResampler *resampler);
+
+
+#endif // FIR_MULTIRATE_H
@@ -0,0 +1,86 @@
+#ifndef FIR_PARALLEL_H
+#define FIR_PARALLEL_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Smallest number of outputs per chunk of the parallel apply functions.
+ */
+#define PARALLEL_MIN_CHUNK_LENGTH 16384
+
+/**
+ * @brief Opaque pool of persistent worker threads.
+ *
+ * The threads are started once and sleep between calls, so a pool can be reused
+ * for many short signals without paying the thread creation cost every time.
+ */
+typedef struct FIRThreadPool FIRThreadPool;
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * The calling thread of every parallel call works as one of the threads,
+ * so thread_count - 1 worker threads are started.
+ *
+ * @param thread_count Number of threads, or 0 for the number of online processors
+ * @return Pointer to the created FIRThreadPool, or NULL on failure
+ */
+FIRThreadPool *create_fir_thread_pool(int thread_count);
+
+/**
+ * @brief Returns the number of threads of a thread pool, including the calling thread.
+ *
+ * @param pool Pointer to the thread pool
+ * @return Number of threads
+ */
+int fir_thread_pool_size(const FIRThreadPool *pool);
+
+/**
+ * @brief Applies the FIR filter to an input signal on the threads of a pool.
+ *
+ * The output is cut into chunks of at least PARALLEL_MIN_CHUNK_LENGTH samples, and every chunk reads
+ * the kernel_length - 1 input samples before it as overlap. The output is bit-identical to the output of apply_fir_filter.
+ *
+ * @param pool Pointer to the thread pool
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_parallel(
+        FIRThreadPool *pool,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Applies the FIR filter to an input signal on the threads of a pool, with the vectorized kernels.
+ *
+ * The output is chunked as in apply_fir_filter_parallel and is bit-identical to the output of apply_fir_filter_simd.
+ *
+ * @param pool Pointer to the thread pool
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ */
+void apply_fir_filter_simd_parallel(
+        FIRThreadPool *pool,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Destroys a thread pool and stops its worker threads.
+ *
+ * @param pool Pointer to the thread pool to be destroyed
+ */
+void destroy_fir_thread_pool(FIRThreadPool *pool);
+
+
+#endif // FIR_PARALLEL_H
@@ -0,0 +1,121 @@
+#ifndef FIR_PARTITIONED_H
+#define FIR_PARTITIONED_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Opaque uniformly partitioned FFT convolver (frequency-domain delay line).
+ *
+ * The kernel is split into partitions of block_length taps, each of which is transformed once.
+ * The convolver keeps the spectra of the last input blocks, so a long kernel can be applied
+ * to a stream in small blocks, with a latency of one block instead of one kernel length.
+ */
+typedef struct FIRPartitionedConvolver FIRPartitionedConvolver;
+
+/**
+ * @brief Creates a uniformly partitioned convolver for a FIR filter.
+ *
+ * The filter coefficients are copied into the convolver in the frequency domain,
+ * so the filter may be destroyed or modified afterwards.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param block_length Number of samples per processed block (power of two, e.g. 64 or 128)
+ * @return Pointer to the created FIRPartitionedConvolver, or NULL on failure
+ */
+FIRPartitionedConvolver *create_fir_partitioned_convolver(const FIRFilter *filter, int block_length);
+
+/**
+ * @brief Returns the block length of a partitioned convolver.
+ *
+ * @param convolver Pointer to the partitioned convolver
+ * @return Block length in samples
+ */
+int fir_partitioned_convolver_block_length(const FIRPartitionedConvolver *convolver);
+
+/**
+ * @brief Filters the next samples of a stream with a partitioned convolver.
+ *
+ * Consecutive calls continue the same stream, so the concatenated output equals the output
+ * of apply_fir_filter over the concatenated input (up to the rounding error of the transforms).
+ *
+ * @param convolver Pointer to the partitioned convolver
+ * @param input_signal Pointer to the next input samples
+ * @param output_signal Pointer to the output samples
+ * @param signal_length Number of samples (multiple of the block length)
+ */
+void process_fir_partitioned_convolver(
+        FIRPartitionedConvolver *convolver,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Resets a partitioned convolver to the start of a new stream (silent history).
+ *
+ * @param convolver Pointer to the partitioned convolver
+ */
+void reset_fir_partitioned_convolver(FIRPartitionedConvolver *convolver);
+
+/**
+ * @brief Destroys a partitioned convolver.
+ *
+ * @param convolver Pointer to the partitioned convolver to be destroyed
+ */
+void destroy_fir_partitioned_convolver(FIRPartitionedConvolver *convolver);
+
+/**
+ * @brief Opaque non-uniformly partitioned convolver for zero-latency filtering with long kernels.
+ *
+ * The first head_length taps are applied in direct form, sample by sample, so the convolver
+ * adds no latency. The rest of the kernel is split into FFT partitions whose block length doubles
+ * along the kernel. Partitions which are far enough in the past are computed by background worker
+ * threads, so the cost of their large transforms is spread over their whole block period.
+ */
+typedef struct FIRNonUniformConvolver FIRNonUniformConvolver;
+
+/**
+ * @brief Creates a non-uniformly partitioned convolver for a FIR filter.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param head_length Length of the direct-form head, also the smallest FFT block length (power of two)
+ * @return Pointer to the created FIRNonUniformConvolver, or NULL on failure
+ */
+FIRNonUniformConvolver *create_fir_nonuniform_convolver(const FIRFilter *filter, int head_length);
+
+/**
+ * @brief Filters the next samples of a stream with a non-uniformly partitioned convolver.
+ *
+ * Any number of samples can be passed per call. Consecutive calls continue the same stream, so the
+ * concatenated output equals the output of apply_fir_filter over the concatenated input
+ * (up to the rounding error of the transforms).
+ *
+ * @param convolver Pointer to the non-uniformly partitioned convolver
+ * @param input_signal Pointer to the next input samples
+ * @param output_signal Pointer to the output samples
+ * @param signal_length Number of samples
+ */
+void process_fir_nonuniform_convolver(
+        FIRNonUniformConvolver *convolver,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Resets a non-uniformly partitioned convolver to the start of a new stream (silent history).
+ *
+ * @param convolver Pointer to the non-uniformly partitioned convolver
+ */
+void reset_fir_nonuniform_convolver(FIRNonUniformConvolver *convolver);
+
+/**
+ * @brief Destroys a non-uniformly partitioned convolver and stops its worker threads.
+ *
+ * @param convolver Pointer to the convolver to be destroyed
+ */
+void destroy_fir_nonuniform_convolver(FIRNonUniformConvolver *convolver);
+
+
+#endif // FIR_PARTITIONED_H
@@ -0,0 +1,107 @@
+#ifndef FIR_PLANNER_H
+#define FIR_PLANNER_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Latency budget which allows any engine, e.g. for offline processing.
+ */
+#define FIR_LATENCY_UNBOUNDED (-1)
+
+/**
+ * @brief Default path of the wisdom file loaded by the CLI, unless the FIR_FILTER_WISDOM environment variable is set.
+ */
+#define FIR_DEFAULT_WISDOM_FILE "fir_filter.wisdom"
+
+/**
+ * @brief Enum for the convolution engines the planner chooses from.
+ */
+typedef enum {
+    FIR_ENGINE_DIRECT,      /**< apply_fir_filter, no latency */
+    FIR_ENGINE_SIMD,        /**< apply_fir_filter_simd, no latency */
+    FIR_ENGINE_TILED,       /**< apply_fir_filter_tiled, no latency */
+    FIR_ENGINE_FFT,         /**< Overlap-save FFT plan, a latency of one transform block */
+    FIR_ENGINE_PARTITIONED  /**< Uniformly partitioned FFT convolver, a latency of one partition */
+} FIREngine;
+
+/**
+ * @brief Returns a printable name of an engine.
+ *
+ * @param engine Convolution engine
+ * @return Name of the engine, e.g. "fft"
+ */
+const char *fir_engine_name(FIREngine engine);
+
+/**
+ * @brief Picks the fastest engine for a filtering problem.
+ *
+ * Engines whose block latency exceeds the latency budget are skipped. With wisdom (calibrated or loaded),
+ * the run times measured on this machine are compared, otherwise the choice follows fixed crossover lengths
+ * for the instruction set level of the running CPU.
+ *
+ * @param kernel_length Length of the filter kernel
+ * @param signal_length Length of the input signal
+ * @param latency_budget Largest acceptable latency in samples, or FIR_LATENCY_UNBOUNDED
+ * @return Fastest engine within the latency budget
+ */
+FIREngine fir_plan_engine(int kernel_length, int signal_length, int latency_budget);
+
+/**
+ * @brief Applies the FIR filter to an input signal with the engine chosen by fir_plan_engine.
+ *
+ * The output is the same as the output of apply_fir_filter, up to the rounding differences of the chosen engine.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ * @param latency_budget Largest acceptable latency in samples, or FIR_LATENCY_UNBOUNDED
+ */
+void apply_fir_filter_planned(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int latency_budget
+);
+
+/**
+ * @brief Measures the engines on this machine and keeps the results as the wisdom of the planner.
+ *
+ * Every engine is timed on a range of kernel lengths, which takes about a second.
+ */
+void fir_planner_calibrate(void);
+
+/**
+ * @brief Returns whether the planner has wisdom (from a calibration or a wisdom file).
+ *
+ * @return 1 if the planner has wisdom, 0 otherwise
+ */
+int fir_planner_has_wisdom(void);
+
+/**
+ * @brief Forgets the wisdom of the planner, so that the fixed crossover lengths are used again.
+ */
+void fir_planner_forget_wisdom(void);
+
+/**
+ * @brief Saves the wisdom of the planner to a text file.
+ *
+ * @param filename Path of the wisdom file
+ * @return 0 on success, -1 if there is no wisdom or the file cannot be written
+ */
+int fir_planner_save_wisdom(const char *filename);
+
+/**
+ * @brief Loads the wisdom of the planner from a text file.
+ *
+ * Wisdom which was calibrated for another instruction set level than the one of the running CPU is rejected.
+ *
+ * @param filename Path of the wisdom file
+ * @return 0 on success, -1 if the file cannot be read, is invalid, or belongs to another instruction set level
+ */
+int fir_planner_load_wisdom(const char *filename);
+
+
+#endif // FIR_PLANNER_H
@@ -0,0 +1,37 @@
+#ifndef FIR_REMEZ_H
+#define FIR_REMEZ_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Creates an equiripple FIR filter with the Parks-McClellan (Remez exchange) algorithm.
+ *
+ * The filter minimizes the largest weighted error against the ideal response (1 in the pass band, 0 in the
+ * stop band) over both bands, so for the same kernel length its ripples are smaller than those of any
+ * windowed sinc, or for the same ripples it needs fewer taps. The ripples are in the inverse ratio of the
+ * weights, e.g. a stop band weight 10 times the pass band weight gives a stop band ripple 10 times smaller
+ * than the pass band ripple. The filter is a linear-phase FIRFilter with the window type REMEZ and the cutoff
+ * frequency in the middle of the transition band, which can be used with every apply engine and the filter file.
+ *
+ * @param type Type of filter (LOW_PASS: passband_edge < stopband_edge, HIGH_PASS: stopband_edge < passband_edge)
+ * @param passband_edge Edge of the pass band in Hz
+ * @param stopband_edge Edge of the stop band in Hz
+ * @param passband_weight Weight of the pass band error (positive)
+ * @param stopband_weight Weight of the stop band error (positive)
+ * @param kernel_length Length of the filter kernel (at least 3, made odd like in create_fir_filter)
+ * @param sample_rate Sampling rate in Hz
+ * @return Pointer to the created FIRFilter, or NULL on failure
+ */
+FIRFilter *create_fir_filter_remez(
+        FilterType type,
+        float passband_edge,
+        float stopband_edge,
+        float passband_weight,
+        float stopband_weight,
+        int kernel_length,
+        float sample_rate
+);
+
+
+#endif // FIR_REMEZ_H
@@ -0,0 +1,60 @@
+#ifndef FIR_STREAM_H
+#define FIR_STREAM_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Opaque streaming direct-form FIR filter with a persistent delay line.
+ *
+ * The stream keeps the last kernel_length - 1 input samples between calls, so a long signal
+ * can be filtered chunk by chunk without the start-up transient of apply_fir_filter at every chunk.
+ * The delay line is stored twice in a buffer of 2 * kernel_length samples, so the inner loop
+ * reads one contiguous window and never wraps around.
+ */
+typedef struct FIRStream FIRStream;
+
+/**
+ * @brief Creates a streaming FIR filter.
+ *
+ * The filter coefficients are copied into the stream, so the filter may be destroyed or modified afterwards.
+ *
+ * @param filter Pointer to the FIR filter
+ * @return Pointer to the created FIRStream, or NULL on failure
+ */
+FIRStream *create_fir_stream(const FIRFilter *filter);
+
+/**
+ * @brief Filters the next samples of a stream.
+ *
+ * Any number of samples can be passed per call. Consecutive calls continue the same stream, so the
+ * concatenated output is sample-identical to the output of apply_fir_filter over the concatenated input.
+ *
+ * @param stream Pointer to the streaming FIR filter
+ * @param input_signal Pointer to the next input samples
+ * @param output_signal Pointer to the output samples
+ * @param signal_length Number of samples
+ */
+void process_fir_stream(
+        FIRStream *stream,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+);
+
+/**
+ * @brief Resets a streaming FIR filter to the start of a new stream (silent history).
+ *
+ * @param stream Pointer to the streaming FIR filter
+ */
+void reset_fir_stream(FIRStream *stream);
+
+/**
+ * @brief Destroys a streaming FIR filter.
+ *
+ * @param stream Pointer to the streaming FIR filter to be destroyed
+ */
+void destroy_fir_stream(FIRStream *stream);
+
+
+#endif // FIR_STREAM_H
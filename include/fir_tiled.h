@@ -0,0 +1,41 @@
+#ifndef FIR_TILED_H
+#define FIR_TILED_H
+
+#include "fir_filter.h"
+
+
+/**
+ * @brief Returns the tile length of the tiled engine which is fastest on the running machine.
+ *
+ * The first call times the candidate tile lengths on a synthetic long kernel (a calibration of
+ * a few hundred milliseconds), later calls return the cached result.
+ *
+ * @return Tile length in samples (a power of two)
+ */
+int fir_tiled_tune_tile_length(void);
+
+/**
+ * @brief Applies the FIR filter to an input signal with a cache-blocked (tiled) direct convolution.
+ *
+ * The outputs and the taps are both cut into tiles of tile_length samples. Each tile of coefficients is applied
+ * to a whole tile of outputs while it is in the L1 cache, instead of streaming the whole kernel once per output.
+ * The tap tiles of an output tile are visited in increasing order and every output is accumulated with the same
+ * multiplications and additions as in apply_fir_filter, so the output is bit-identical to the output of apply_fir_filter.
+ * This pays off for kernels which do not fit in the L1 cache, from a few thousand taps on.
+ *
+ * @param filter Pointer to the FIR filter
+ * @param input_signal Pointer to the input signal array
+ * @param output_signal Pointer to the output signal array
+ * @param signal_length Length of the input signal
+ * @param tile_length Tile length in samples, or 0 for the tuned tile length (fir_tiled_tune_tile_length)
+ */
+void apply_fir_filter_tiled(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int tile_length
+);
+
+
+#endif // FIR_TILED_H
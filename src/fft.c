@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// A real transform of size N is computed as a complex transform of size N/2,
+// where the even samples form the real part and the odd samples the imaginary part.
+// The two interleaved half-size spectra are then separated with the "real twiddles" e^(-2*pi*i*k/N).
+struct FFTPlan {
+    int size;               // Real transform size N
+    int half_size;          // Complex transform size n = N/2
+    float *twiddles;        // e^(-2*pi*i*k/n) for k < n/2, interleaved complex
+    float *real_twiddles;   // e^(-2*pi*i*k/N) for k < n, interleaved complex
+    int *bit_reverse;       // Bit-reversal permutation of the complex transform
+};
+
+// API endpoint to create a FFT plan
+FFTPlan *create_fft_plan(int size) {
+    // Validate the input parameters
+    if (size < 2 || (size & (size - 1)) != 0) {
+        fprintf(stderr, "create_fft_plan: The transform size must be a power of two and at least 2.\n");
+        return NULL;
+    }
+
+    FFTPlan *plan = (FFTPlan *) malloc(sizeof(FFTPlan));
+    if (plan == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FFTPlan\n");
+        return NULL;
+    }
+
+    int n = size / 2;
+    plan->size = size;
+    plan->half_size = n;
+    plan->twiddles = (float *) malloc((n / 2 + 1) * 2 * sizeof(float));
+    plan->real_twiddles = (float *) malloc(n * 2 * sizeof(float));
+    plan->bit_reverse = (int *) malloc(n * sizeof(int));
+    if (plan->twiddles == NULL || plan->real_twiddles == NULL || plan->bit_reverse == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FFT tables\n");
+        destroy_fft_plan(plan);
+        return NULL;
+    }
+
+    // The twiddle factors are calculated in double precision to keep the rounding error
+    // of the tables well below the rounding error of the transform itself
+    for (int k = 0; k < n / 2; ++k) {
+        double angle = -2.0 * M_PI * (double) k / (double) n;
+        plan->twiddles[2 * k] = (float) cos(angle);
+        plan->twiddles[2 * k + 1] = (float) sin(angle);
+    }
+    for (int k = 0; k < n; ++k) {
+        double angle = -2.0 * M_PI * (double) k / (double) size;
+        plan->real_twiddles[2 * k] = (float) cos(angle);
+        plan->real_twiddles[2 * k + 1] = (float) sin(angle);
+    }
+
+    // Bit-reversal permutation of the indices of the complex transform
+    int bits = 0;
+    while ((1 << bits) < n) ++bits;
+    for (int i = 0; i < n; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            if (i & (1 << b)) reversed |= 1 << (bits - 1 - b);
+        }
+        plan->bit_reverse[i] = reversed;
+    }
+
+    return plan;
+}
+
+int fft_plan_size(const FFTPlan *plan) {
+    return plan != NULL ? plan->size : 0;
+}
+
+int fft_next_size(int n) {
+    int size = 2;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+// In-place iterative radix-2 decimation-in-time complex transform on interleaved data.
+// The inverse direction uses the conjugated twiddle factors and is not normalized.
+static void complex_fft(const FFTPlan *plan, float *data, int inverse) {
+    int n = plan->half_size;
+
+    // Reorder the input in bit-reversed order
+    for (int i = 0; i < n; ++i) {
+        int j = plan->bit_reverse[i];
+        if (i < j) {
+            float re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    // Butterfly stages
+    float sign = inverse ? -1.0f : 1.0f;
+    for (int length = 2; length <= n; length <<= 1) {
+        int half = length / 2;
+        int step = n / length;
+        for (int start = 0; start < n; start += length) {
+            for (int k = 0; k < half; ++k) {
+                float w_re = plan->twiddles[2 * k * step];
+                float w_im = sign * plan->twiddles[2 * k * step + 1];
+                float *u = data + 2 * (start + k);
+                float *v = data + 2 * (start + k + half);
+                float t_re = v[0] * w_re - v[1] * w_im;
+                float t_im = v[0] * w_im + v[1] * w_re;
+                v[0] = u[0] - t_re;
+                v[1] = u[1] - t_im;
+                u[0] += t_re;
+                u[1] += t_im;
+            }
+        }
+    }
+}
+
+// API endpoint for the forward real transform
+void fft_forward(const FFTPlan *plan, const float *input, float *spectrum) {
+    int n = plan->half_size;
+
+    // Pack the real signal into a complex signal of half the length (z[k] = x[2k] + i*x[2k+1])
+    for (int i = 0; i < 2 * n; ++i) {
+        spectrum[i] = input[i];
+    }
+    complex_fft(plan, spectrum, 0);
+
+    // Separate the spectra of the even and odd samples and combine them into the real spectrum:
+    // X[k] = E[k] + W^k * O[k] and X[n-k] = conj(E[k] - W^k * O[k])
+    float z0_re = spectrum[0], z0_im = spectrum[1];
+    spectrum[0] = z0_re + z0_im;
+    spectrum[1] = 0.0f;
+    spectrum[2 * n] = z0_re - z0_im;
+    spectrum[2 * n + 1] = 0.0f;
+    for (int k = 1; k <= n / 2; ++k) {
+        int j = n - k;
+        float zk_re = spectrum[2 * k], zk_im = spectrum[2 * k + 1];
+        float zj_re = spectrum[2 * j], zj_im = spectrum[2 * j + 1];
+
+        float e_re = 0.5f * (zk_re + zj_re);
+        float e_im = 0.5f * (zk_im - zj_im);
+        float o_re = 0.5f * (zk_im + zj_im);
+        float o_im = -0.5f * (zk_re - zj_re);
+
+        float w_re = plan->real_twiddles[2 * k], w_im = plan->real_twiddles[2 * k + 1];
+        float t_re = o_re * w_re - o_im * w_im;
+        float t_im = o_re * w_im + o_im * w_re;
+
+        spectrum[2 * k] = e_re + t_re;
+        spectrum[2 * k + 1] = e_im + t_im;
+        spectrum[2 * j] = e_re - t_re;
+        spectrum[2 * j + 1] = -(e_im - t_im);
+    }
+}
+
+// API endpoint for the normalized inverse real transform
+void fft_inverse(const FFTPlan *plan, const float *spectrum, float *output) {
+    int n = plan->half_size;
+
+    // Rebuild the half-length complex spectrum Z[k] = E[k] + i*O[k] from the real spectrum
+    for (int k = 0; k < n; ++k) {
+        int j = n - k;
+        float xk_re = spectrum[2 * k], xk_im = spectrum[2 * k + 1];
+        float xj_re = spectrum[2 * j], xj_im = spectrum[2 * j + 1];
+
+        float e_re = 0.5f * (xk_re + xj_re);
+        float e_im = 0.5f * (xk_im - xj_im);
+        float d_re = 0.5f * (xk_re - xj_re);
+        float d_im = 0.5f * (xk_im + xj_im);
+
+        // O[k] = D * W^(-k)
+        float w_re = plan->real_twiddles[2 * k], w_im = -plan->real_twiddles[2 * k + 1];
+        float o_re = d_re * w_re - d_im * w_im;
+        float o_im = d_re * w_im + d_im * w_re;
+
+        output[2 * k] = e_re - o_im;
+        output[2 * k + 1] = e_im + o_re;
+    }
+    complex_fft(plan, output, 1);
+
+    // Normalize, the unpacked complex result is the real signal itself
+    float scale = 1.0f / (float) n;
+    for (int i = 0; i < 2 * n; ++i) {
+        output[i] *= scale;
+    }
+}
+
+void fft_multiply_accumulate(const float *a, const float *b, float *accumulator, int bins) {
+    for (int k = 0; k < bins; ++k) {
+        float a_re = a[2 * k], a_im = a[2 * k + 1];
+        float b_re = b[2 * k], b_im = b[2 * k + 1];
+        accumulator[2 * k] += a_re * b_re - a_im * b_im;
+        accumulator[2 * k + 1] += a_re * b_im + a_im * b_re;
+    }
+}
+
+// API endpoint to free the memory held by the plan
+void destroy_fft_plan(FFTPlan *plan) {
+    if (plan != NULL) {
+        free(plan->twiddles);
+        free(plan->real_twiddles);
+        free(plan->bit_reverse);
+        free(plan);
+    }
+}
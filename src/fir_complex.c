@@ -0,0 +1,584 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fir_complex.h"
+#include "fir_filter_internal.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// The kernels of a real filter on an interleaved complex signal work on the flat float array: float output k
+// is the sum of h[j] * x[k - 2 * j], so a vector of consecutive floats holds whole I/Q samples and every
+// broadcast coefficient serves both components. They compute the floats [begin, end) (twice the complex sample
+// indexes), for which the full kernel overlaps the signal, with the per-output arithmetic of the kernels
+// of apply_fir_filter_simd, so that I and Q equal the outputs of the real engine on the separated components.
+typedef void (*DirectKernel)(const float *coefficients, int kernel_length, const float *input, float *output,
+                             int begin, int end);
+typedef void (*FoldedKernel)(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                             float *output, int begin, int end);
+
+static void direct_kernel_scalar(const float *coefficients, int kernel_length, const float *input, float *output,
+                                 int begin, int end) {
+    for (int k = begin; k < end; ++k) {
+        float sum = 0.0f;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum += coefficients[j] * input[k - 2 * j];
+        }
+        output[k] = sum;
+    }
+}
+
+// Symmetric filters are folded and half-band filters skip their structural zeros, as in apply_fir_filter_simd
+static void folded_kernel_scalar(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                 float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    for (int k = begin; k < end; ++k) {
+        float sum = 0.0f;
+        for (int j = first; j < half; j += tap_step) {
+            sum += coefficients[j] * (input[k - 2 * j] + input[k - 2 * (last - j)]);
+        }
+        if (kernel_length & 1) {
+            sum += coefficients[half] * input[k - 2 * half];
+        }
+        output[k] = sum;
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void direct_kernel_sse41(const float *coefficients, int kernel_length, const float *input, float *output,
+                                int begin, int end) {
+    int k = begin;
+    for (; k + 16 <= end; k += 16) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + k - 2 * j;
+            __m128 h = _mm_set1_ps(coefficients[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+        }
+        _mm_storeu_ps(output + k, acc0);
+        _mm_storeu_ps(output + k + 4, acc1);
+        _mm_storeu_ps(output + k + 8, acc2);
+        _mm_storeu_ps(output + k + 12, acc3);
+    }
+    direct_kernel_scalar(coefficients, kernel_length, input, output, k, end);
+}
+
+__attribute__((target("sse4.1")))
+static void folded_kernel_sse41(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int k = begin;
+    for (; k + 16 <= end; k += 16) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + k - 2 * j;
+            const float *m = input + k - 2 * (last - j);
+            __m128 h = _mm_set1_ps(coefficients[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x), _mm_loadu_ps(m))));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 4), _mm_loadu_ps(m + 4))));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 8), _mm_loadu_ps(m + 8))));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 12), _mm_loadu_ps(m + 12))));
+        }
+        if (kernel_length & 1) {
+            const float *x = input + k - 2 * half;
+            __m128 h = _mm_set1_ps(coefficients[half]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+        }
+        _mm_storeu_ps(output + k, acc0);
+        _mm_storeu_ps(output + k + 4, acc1);
+        _mm_storeu_ps(output + k + 8, acc2);
+        _mm_storeu_ps(output + k + 12, acc3);
+    }
+    folded_kernel_scalar(coefficients, kernel_length, tap_step, input, output, k, end);
+}
+
+// Scalar remainders of the FMA kernels, with the same per-output arithmetic as the vector lanes
+__attribute__((target("avx2,fma")))
+static void direct_kernel_tail_fma(const float *coefficients, int kernel_length, const float *input, float *output,
+                                   int begin, int end) {
+    for (int k = begin; k < end; ++k) {
+        float sum = 0.0f;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum = fmaf(coefficients[j], input[k - 2 * j], sum);
+        }
+        output[k] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_tail_fma(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                   float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    for (int k = begin; k < end; ++k) {
+        float sum = 0.0f;
+        for (int j = first; j < half; j += tap_step) {
+            sum = fmaf(coefficients[j], input[k - 2 * j] + input[k - 2 * (last - j)], sum);
+        }
+        if (kernel_length & 1) {
+            sum = fmaf(coefficients[half], input[k - 2 * half], sum);
+        }
+        output[k] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void direct_kernel_avx2(const float *coefficients, int kernel_length, const float *input, float *output,
+                               int begin, int end) {
+    int k = begin;
+    for (; k + 32 <= end; k += 32) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + k - 2 * j;
+            __m256 h = _mm256_broadcast_ss(coefficients + j);
+            acc0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 8), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 16), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 24), acc3);
+        }
+        _mm256_storeu_ps(output + k, acc0);
+        _mm256_storeu_ps(output + k + 8, acc1);
+        _mm256_storeu_ps(output + k + 16, acc2);
+        _mm256_storeu_ps(output + k + 24, acc3);
+    }
+    for (; k + 8 <= end; k += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm256_fmadd_ps(_mm256_broadcast_ss(coefficients + j), _mm256_loadu_ps(input + k - 2 * j), acc);
+        }
+        _mm256_storeu_ps(output + k, acc);
+    }
+    direct_kernel_tail_fma(coefficients, kernel_length, input, output, k, end);
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_avx2(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                               float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int k = begin;
+    for (; k + 32 <= end; k += 32) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + k - 2 * j;
+            const float *m = input + k - 2 * (last - j);
+            __m256 h = _mm256_broadcast_ss(coefficients + j);
+            acc0 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x), _mm256_loadu_ps(m)), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 8), _mm256_loadu_ps(m + 8)), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 16), _mm256_loadu_ps(m + 16)), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 24), _mm256_loadu_ps(m + 24)), acc3);
+        }
+        if (kernel_length & 1) {
+            const float *x = input + k - 2 * half;
+            __m256 h = _mm256_broadcast_ss(coefficients + half);
+            acc0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 8), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 16), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 24), acc3);
+        }
+        _mm256_storeu_ps(output + k, acc0);
+        _mm256_storeu_ps(output + k + 8, acc1);
+        _mm256_storeu_ps(output + k + 16, acc2);
+        _mm256_storeu_ps(output + k + 24, acc3);
+    }
+    folded_kernel_tail_fma(coefficients, kernel_length, tap_step, input, output, k, end);
+}
+
+__attribute__((target("avx512f")))
+static void direct_kernel_avx512(const float *coefficients, int kernel_length, const float *input, float *output,
+                                 int begin, int end) {
+    int k = begin;
+    for (; k + 64 <= end; k += 64) {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + k - 2 * j;
+            __m512 h = _mm512_set1_ps(coefficients[j]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 16), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 32), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 48), acc3);
+        }
+        _mm512_storeu_ps(output + k, acc0);
+        _mm512_storeu_ps(output + k + 16, acc1);
+        _mm512_storeu_ps(output + k + 32, acc2);
+        _mm512_storeu_ps(output + k + 48, acc3);
+    }
+    for (; k + 16 <= end; k += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[j]), _mm512_loadu_ps(input + k - 2 * j), acc);
+        }
+        _mm512_storeu_ps(output + k, acc);
+    }
+    direct_kernel_tail_fma(coefficients, kernel_length, input, output, k, end);
+}
+
+__attribute__((target("avx512f")))
+static void folded_kernel_avx512(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                 float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int k = begin;
+    for (; k + 64 <= end; k += 64) {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + k - 2 * j;
+            const float *m = input + k - 2 * (last - j);
+            __m512 h = _mm512_set1_ps(coefficients[j]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x), _mm512_loadu_ps(m)), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 16), _mm512_loadu_ps(m + 16)), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 32), _mm512_loadu_ps(m + 32)), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 48), _mm512_loadu_ps(m + 48)), acc3);
+        }
+        if (kernel_length & 1) {
+            const float *x = input + k - 2 * half;
+            __m512 h = _mm512_set1_ps(coefficients[half]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 16), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 32), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 48), acc3);
+        }
+        _mm512_storeu_ps(output + k, acc0);
+        _mm512_storeu_ps(output + k + 16, acc1);
+        _mm512_storeu_ps(output + k + 32, acc2);
+        _mm512_storeu_ps(output + k + 48, acc3);
+    }
+    folded_kernel_tail_fma(coefficients, kernel_length, tap_step, input, output, k, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the direct kernel of the given level, limited to the level supported by the running CPU
+static DirectKernel select_direct_kernel(FIRSimdLevel level) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return direct_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return direct_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return direct_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return direct_kernel_scalar;
+}
+
+// Select the folded kernel of the given level, limited to the level supported by the running CPU
+static FoldedKernel select_folded_kernel(FIRSimdLevel level) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return folded_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return folded_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return folded_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return folded_kernel_scalar;
+}
+
+void apply_fir_filter_complex_level(
+        FIRSimdLevel level,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_complex: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // The first kernel_length-1 samples only overlap a part of the kernel, they are calculated as in apply_fir_filter
+    int kernel_length = filter->kernel_length;
+    for (int k = 0; k < 2 * MIN(kernel_length - 1, signal_length); ++k) {
+        float sum = 0.0f;
+        for (int j = 0; j < k / 2 + 1; ++j) {
+            sum += filter->coefficients[j] * input_signal[k - 2 * j];
+        }
+        output_signal[k] = sum;
+    }
+
+    // Both components of the rest of the samples are calculated by the vectorized kernels
+    int begin = 2 * (kernel_length - 1);
+    int end = 2 * signal_length;
+    if (begin >= end) {
+        return;
+    }
+    if (filter->is_half_band || filter->is_symmetric) {
+        FoldedKernel kernel = select_folded_kernel(level);
+        kernel(filter->coefficients, kernel_length, filter->is_half_band ? 2 : 1, input_signal, output_signal,
+               begin, end);
+    } else {
+        DirectKernel kernel = select_direct_kernel(level);
+        kernel(filter->coefficients, kernel_length, input_signal, output_signal, begin, end);
+    }
+}
+
+// API endpoint for applying the real filter to a complex signal with the best kernel for the running CPU
+void apply_fir_filter_complex(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_complex_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
+
+FIRFilterComplex *create_fir_filter_complex(const float *coefficients, int kernel_length) {
+    // Validate the input parameters
+    if (coefficients == NULL || kernel_length <= 0) {
+        fprintf(stderr, "create_fir_filter_complex: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFilterComplex *filter = (FIRFilterComplex *) malloc(sizeof(FIRFilterComplex));
+    if (filter == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilterComplex\n");
+        return NULL;
+    }
+    filter->kernel_length = kernel_length;
+    filter->coefficients = (float *) malloc(2 * kernel_length * sizeof(float));
+    if (filter->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the complex filter\n");
+        free(filter);
+        return NULL;
+    }
+    memcpy(filter->coefficients, coefficients, 2 * kernel_length * sizeof(float));
+    return filter;
+}
+
+FIRFilterComplex *shift_fir_filter_complex(const FIRFilter *prototype, float center_freq) {
+    // Validate the input parameters
+    if (prototype == NULL || prototype->coefficients == NULL || prototype->kernel_length <= 0 ||
+        prototype->sample_rate <= 0 || fabsf(center_freq) >= prototype->sample_rate / 2.0f) {
+        fprintf(stderr, "shift_fir_filter_complex: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    int kernel_length = prototype->kernel_length;
+    float *coefficients = (float *) malloc(2 * kernel_length * sizeof(float));
+    if (coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the complex filter\n");
+        return NULL;
+    }
+
+    // The phasor is evaluated in double, relative to the center tap
+    double step = 2.0 * M_PI * (double) center_freq / (double) prototype->sample_rate;
+    double center = (double) (kernel_length - 1) / 2.0;
+    for (int n = 0; n < kernel_length; ++n) {
+        double phase = step * ((double) n - center);
+        coefficients[2 * n] = (float) (prototype->coefficients[n] * cos(phase));
+        coefficients[2 * n + 1] = (float) (prototype->coefficients[n] * sin(phase));
+    }
+
+    FIRFilterComplex *filter = create_fir_filter_complex(coefficients, kernel_length);
+    free(coefficients);
+    return filter;
+}
+
+// The kernels of a complex filter compute the complex outputs [begin, end), for which the full kernel overlaps
+// the signal. The sums a = sum_j re(h[j]) * x[i - j] and b = sum_j im(h[j]) * x[i - j] are accumulated
+// over whole complex samples, and the output is re(y) = re(a) - im(b), im(y) = im(a) + re(b).
+typedef void (*ComplexKernel)(const float *coefficients, int kernel_length, const float *input, float *output,
+                              int begin, int end);
+
+static void complex_kernel_scalar(const float *coefficients, int kernel_length, const float *input, float *output,
+                                  int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float a_re = 0.0f, a_im = 0.0f, b_re = 0.0f, b_im = 0.0f;
+        for (int j = 0; j < MIN(kernel_length, i + 1); ++j) {
+            const float *x = input + 2 * (i - j);
+            a_re += coefficients[2 * j] * x[0];
+            a_im += coefficients[2 * j] * x[1];
+            b_re += coefficients[2 * j + 1] * x[0];
+            b_im += coefficients[2 * j + 1] * x[1];
+        }
+        output[2 * i] = a_re - b_im;
+        output[2 * i + 1] = a_im + b_re;
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void complex_kernel_sse41(const float *coefficients, int kernel_length, const float *input, float *output,
+                                 int begin, int end) {
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps(), b0 = _mm_setzero_ps(), b1 = _mm_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + 2 * (i - j);
+            __m128 h_re = _mm_set1_ps(coefficients[2 * j]);
+            __m128 h_im = _mm_set1_ps(coefficients[2 * j + 1]);
+            __m128 x0 = _mm_loadu_ps(x), x1 = _mm_loadu_ps(x + 4);
+            a0 = _mm_add_ps(a0, _mm_mul_ps(h_re, x0));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(h_re, x1));
+            b0 = _mm_add_ps(b0, _mm_mul_ps(h_im, x0));
+            b1 = _mm_add_ps(b1, _mm_mul_ps(h_im, x1));
+        }
+        // Swap the components of b within every sample, then subtract in the real and add in the imaginary lanes
+        _mm_storeu_ps(output + 2 * i, _mm_addsub_ps(a0, _mm_shuffle_ps(b0, b0, 0xB1)));
+        _mm_storeu_ps(output + 2 * i + 4, _mm_addsub_ps(a1, _mm_shuffle_ps(b1, b1, 0xB1)));
+    }
+    complex_kernel_scalar(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx2,fma")))
+static void complex_kernel_tail_fma(const float *coefficients, int kernel_length, const float *input, float *output,
+                                    int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float a_re = 0.0f, a_im = 0.0f, b_re = 0.0f, b_im = 0.0f;
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + 2 * (i - j);
+            a_re = fmaf(coefficients[2 * j], x[0], a_re);
+            a_im = fmaf(coefficients[2 * j], x[1], a_im);
+            b_re = fmaf(coefficients[2 * j + 1], x[0], b_re);
+            b_im = fmaf(coefficients[2 * j + 1], x[1], b_im);
+        }
+        output[2 * i] = a_re - b_im;
+        output[2 * i + 1] = a_im + b_re;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void complex_kernel_avx2(const float *coefficients, int kernel_length, const float *input, float *output,
+                                int begin, int end) {
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        __m256 b0 = _mm256_setzero_ps(), b1 = _mm256_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + 2 * (i - j);
+            __m256 h_re = _mm256_broadcast_ss(coefficients + 2 * j);
+            __m256 h_im = _mm256_broadcast_ss(coefficients + 2 * j + 1);
+            __m256 x0 = _mm256_loadu_ps(x), x1 = _mm256_loadu_ps(x + 8);
+            a0 = _mm256_fmadd_ps(h_re, x0, a0);
+            a1 = _mm256_fmadd_ps(h_re, x1, a1);
+            b0 = _mm256_fmadd_ps(h_im, x0, b0);
+            b1 = _mm256_fmadd_ps(h_im, x1, b1);
+        }
+        _mm256_storeu_ps(output + 2 * i, _mm256_addsub_ps(a0, _mm256_permute_ps(b0, 0xB1)));
+        _mm256_storeu_ps(output + 2 * i + 8, _mm256_addsub_ps(a1, _mm256_permute_ps(b1, 0xB1)));
+    }
+    complex_kernel_tail_fma(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void complex_kernel_avx512(const float *coefficients, int kernel_length, const float *input, float *output,
+                                  int begin, int end) {
+    // The real parts are the even lanes
+    const __mmask16 real_lanes = 0x5555;
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+        __m512 b0 = _mm512_setzero_ps(), b1 = _mm512_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + 2 * (i - j);
+            __m512 h_re = _mm512_set1_ps(coefficients[2 * j]);
+            __m512 h_im = _mm512_set1_ps(coefficients[2 * j + 1]);
+            __m512 x0 = _mm512_loadu_ps(x), x1 = _mm512_loadu_ps(x + 16);
+            a0 = _mm512_fmadd_ps(h_re, x0, a0);
+            a1 = _mm512_fmadd_ps(h_re, x1, a1);
+            b0 = _mm512_fmadd_ps(h_im, x0, b0);
+            b1 = _mm512_fmadd_ps(h_im, x1, b1);
+        }
+        __m512 swapped0 = _mm512_permute_ps(b0, 0xB1), swapped1 = _mm512_permute_ps(b1, 0xB1);
+        _mm512_storeu_ps(output + 2 * i, _mm512_mask_sub_ps(_mm512_add_ps(a0, swapped0), real_lanes, a0, swapped0));
+        _mm512_storeu_ps(output + 2 * i + 16,
+                         _mm512_mask_sub_ps(_mm512_add_ps(a1, swapped1), real_lanes, a1, swapped1));
+    }
+    complex_kernel_avx2(coefficients, kernel_length, input, output, i, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the complex kernel of the given level, limited to the level supported by the running CPU
+static ComplexKernel select_complex_kernel(FIRSimdLevel level) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return complex_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return complex_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return complex_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return complex_kernel_scalar;
+}
+
+void apply_fir_filter_complex_taps_level(
+        FIRSimdLevel level,
+        const FIRFilterComplex *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 || input_signal == NULL ||
+        output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_complex_taps: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // The first kernel_length-1 samples only overlap a part of the kernel
+    int kernel_length = filter->kernel_length;
+    int begin = MIN(kernel_length - 1, signal_length);
+    complex_kernel_scalar(filter->coefficients, kernel_length, input_signal, output_signal, 0, begin);
+    if (begin < signal_length) {
+        ComplexKernel kernel = select_complex_kernel(level);
+        kernel(filter->coefficients, kernel_length, input_signal, output_signal, begin, signal_length);
+    }
+}
+
+// API endpoint for applying the complex filter with the best kernel for the running CPU
+void apply_fir_filter_complex_taps(
+        const FIRFilterComplex *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_complex_taps_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
+
+// API endpoint to free the memory held by the complex filter
+void destroy_fir_filter_complex(FIRFilterComplex *filter) {
+    if (filter != NULL) {
+        free(filter->coefficients);
+        free(filter);
+    }
+}
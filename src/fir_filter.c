@@ -1,51 +1,81 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <limits.h>
 #include "fir_filter.h"
+#include "fir_filter_internal.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-#define BESSEL_FUNCTION_APPROXIMATION 25
-#define MIN(a, b) ((a) < (b) ? (a) : (b))
+// Upper limit and relative size of the last term of the Bessel function series
+#define BESSEL_MAX_TERMS 200
+#define BESSEL_TERM_TOLERANCE 1e-9
+// Number of window taps evaluated together by the batch form of the Kaiser window
+#define KAISER_BATCH_LENGTH 64
 
-// Generate a factorial list of values up to the specified number
-// Precision starts to decay after 14!, but it doesn't matter for larger numbers
-// because the factorials are used for division
-static void generate_factorials(int up_to, float *factorial_list) {
-    float factorial_term = 1.0f;
-    for (int i = 1; i <= up_to; ++i) {
-        factorial_term *= (float) i;
-        factorial_list[i - 1] = factorial_term;
+// Number of terms of the series of I0(beta) up to the first term which no longer changes the sum.
+// The terms ((x/2)^k / k!)^2 grow with x, so this count is enough for every argument x <= beta of the window.
+static int bessel_term_count(float beta_param) {
+    double quarter_beta_squared = (double) beta_param * (double) beta_param / 4.0;
+    double term = 1.0;
+    double sum = 1.0;
+    int term_count = 0;
+    while (term > sum * BESSEL_TERM_TOLERANCE && term_count < BESSEL_MAX_TERMS) {
+        ++term_count;
+        term *= quarter_beta_squared / ((double) term_count * (double) term_count);
+        sum += term;
     }
+    return term_count;
 }
 
 // Function to calculate the modified zero order Bessel function of the 1st kind (i.e. I0(x))
-// for the Kaiser window calculation
-static float I0(float x, const float *factorial_list) {
+// from its squared argument (x/2)^2: every term of the power series is obtained from the previous one,
+// term_k = term_(k-1) * (x/2)^2 / k^2, without powers or factorials
+static float I0(float quarter_x_squared, int term_count) {
+    float term = 1.0f;
     float result = 1.0f;
-    float half_x = x / 2.0f;
-    for (int j = 1; j <= BESSEL_FUNCTION_APPROXIMATION; ++j) {
-        float term = powf(half_x, (float) j) / factorial_list[j - 1];
-        result += powf(term, 2.0f);
+    for (int k = 1; k <= term_count; ++k) {
+        term *= quarter_x_squared / (float) (k * k);
+        result += term;
     }
     return result;
 }
 
-// Function to calculate the Kaiser window terms
-static float kaiser_window_function(
-        float beta_param,
-        float I0_beta,
-        const float *factorial_list,
-        int kernel_length,
-        int n
-) {
-    // Normalized window position: (2 * n) / (N - 1)
-    float normalized_win_pos = (float) (2 * n) / (float) (kernel_length - 1);
-    // Calculate the term which will be plugged into the Bessel function
-    float nominator_term = beta_param * sqrtf(1.0f - powf(normalized_win_pos, 2.0f));
-    return I0(nominator_term, factorial_list) / I0_beta;
+// Batch form of the Kaiser window: the window of every tap is written to window[0 .. kernel_length-1].
+// The taps are evaluated in batches with the series terms in the outer loop, so that the inner loop over the taps
+// has no dependencies and is vectorized by the compiler. The argument of I0 is (beta/2)^2 * (1 - (2n / (N-1))^2),
+// so neither a square root nor a power is needed.
+static void kaiser_window(float beta_param, int kernel_length, float *window) {
+    int term_count = bessel_term_count(beta_param);
+    float quarter_beta_squared = beta_param * beta_param / 4.0f;
+    float I0_beta = I0(quarter_beta_squared, term_count);
+    int half_M = (kernel_length - 1) / 2;
+
+    float argument[KAISER_BATCH_LENGTH];
+    float term[KAISER_BATCH_LENGTH];
+    float sum[KAISER_BATCH_LENGTH];
+    for (int start = 0; start < kernel_length; start += KAISER_BATCH_LENGTH) {
+        int count = MIN(KAISER_BATCH_LENGTH, kernel_length - start);
+        for (int t = 0; t < count; ++t) {
+            // Normalized window position: (2 * n) / (N - 1), with n counted from the center tap
+            float normalized_win_pos = (float) (2 * (start + t - half_M)) / (float) (kernel_length - 1);
+            argument[t] = quarter_beta_squared * (1.0f - normalized_win_pos * normalized_win_pos);
+            term[t] = 1.0f;
+            sum[t] = 1.0f;
+        }
+        for (int k = 1; k <= term_count; ++k) {
+            float inverse_k_squared = 1.0f / (float) (k * k);
+            for (int t = 0; t < count; ++t) {
+                term[t] *= argument[t] * inverse_k_squared;
+                sum[t] += term[t];
+            }
+        }
+        for (int t = 0; t < count; ++t) {
+            window[start + t] = sum[t] / I0_beta;
+        }
+    }
 }
 
 // Calculate the window function term based on the window type
@@ -71,27 +101,17 @@ static float window_function(WindowType window, int kernel_length, int n) {
 static void generate_sinc(FIRFilter *filter) {
     // Calculate the normalized cutoff frequency
     float normalized_cutoff_freq = 2.0f * filter->cutoff_freq / filter->sample_rate;
+    // A band-pass filter is the difference of the low-pass filters at the upper and the lower edge
+    int is_band = filter->type == BAND_PASS || filter->type == BAND_STOP;
+    float normalized_cutoff_freq_high = 2.0f * filter->cutoff_freq_high / filter->sample_rate;
     // Define the range of values for n as half of the interval count
     int half_M = (filter->kernel_length - 1) / 2;
-    // Additional values for the Kaiser window calculations
-    int is_window_kaiser = filter->window == KAISER_B6 || filter->window == KAISER_B8 || filter->window == KAISER_B10;
-    float *factorial_list = NULL;
-    float beta_param = 0.0f;
-    float I0_beta = 0.0f;
+    // The Kaiser window is calculated for all taps at once, directly into the coefficients,
+    // which are then multiplied with the sinc function in place
+    int is_window_kaiser = filter->window == KAISER_B6 || filter->window == KAISER_B8 ||
+                           filter->window == KAISER_B10 || filter->window == KAISER;
     if (is_window_kaiser) {
-        factorial_list = (float *) malloc(BESSEL_FUNCTION_APPROXIMATION * sizeof(float));
-        if (factorial_list == NULL) {
-            fprintf(stderr, "Memory allocation for Kaiser window calculation failed.\n");
-            free(filter->coefficients);
-            free(filter);
-            filter = NULL;
-            return;
-        }
-        generate_factorials(BESSEL_FUNCTION_APPROXIMATION, factorial_list);
-        if (filter->window == KAISER_B6) beta_param = 6.0f;
-        if (filter->window == KAISER_B8) beta_param = 8.0f;
-        if (filter->window == KAISER_B10) beta_param = 10.0f;
-        I0_beta = I0(beta_param, factorial_list);
+        kaiser_window(filter->kaiser_beta, filter->kernel_length, filter->coefficients);
     }
 
     // Generate the filter coefficients according to the filter and window type
@@ -103,54 +123,62 @@ static void generate_sinc(FIRFilter *filter) {
         float pi_times_n = (float) M_PI * (float) n;
 
         // Find the pure sinc function coefficients
+        float sinc;
         if (n == 0) {
-            *coefficient_ptr = normalized_cutoff_freq;
+            sinc = normalized_cutoff_freq;
         } else {
-            *coefficient_ptr = sinf(normalized_cutoff_freq * pi_times_n) / pi_times_n;
+            sinc = sinf(normalized_cutoff_freq * pi_times_n) / pi_times_n;
+        }
+        if (is_band) {
+            float sinc_high = n == 0 ? normalized_cutoff_freq_high :
+                              sinf(normalized_cutoff_freq_high * pi_times_n) / pi_times_n;
+            sinc = sinc_high - sinc;
         }
 
         // Apply the window function to the pure sinc function, to get the impulse response of the filter
         // h[n] = h[n] * w[n]
         if (is_window_kaiser) {
-            *coefficient_ptr *= kaiser_window_function(beta_param, I0_beta, factorial_list, filter->kernel_length, n);
+            *coefficient_ptr = sinc * *coefficient_ptr;
         } else {
-            *coefficient_ptr *= window_function(filter->window, filter->kernel_length, n);
+            *coefficient_ptr = sinc * window_function(filter->window, filter->kernel_length, n);
         }
 
         // To obtain HP filter from the LP, we need to perform spectral inversion of the IR.
         // The spectral inversion of a filter h[n] is defined as follows:
         // 1) Change the sign of each value in h[n]
         // 2) Add one to the value in the center.
-        if (filter->type == HIGH_PASS) {
+        // The band-stop filter is obtained from the band-pass filter in the same way.
+        if (filter->type == HIGH_PASS || filter->type == BAND_STOP) {
             *coefficient_ptr *= -1;
             if (n == 0) *coefficient_ptr += 1;
         }
     }
+}
 
-    // Free the factorial list, if it was used (i.e. if the window type was Kaiser)
-    if (factorial_list != NULL) {
-        free(factorial_list);
+// Beta parameter of the Kaiser windows with a fixed beta
+float fir_kaiser_window_beta(WindowType window) {
+    switch (window) {
+        case KAISER_B6:
+            return 6.0f;
+        case KAISER_B8:
+            return 8.0f;
+        case KAISER_B10:
+            return 10.0f;
+        default:
+            return 0.0f;
     }
 }
 
-// API endpoint to create a FIR filter
-FIRFilter *create_fir_filter(
+// Allocate and design a filter, the parameters are already validated and the kernel length is odd
+static FIRFilter *design_fir_filter(
         FilterType type,
         WindowType window,
+        float kaiser_beta,
         float cutoff_freq,
+        float cutoff_freq_high,
         int kernel_length,
         float sample_rate
 ) {
-    // Validate the input parameters
-    if (cutoff_freq <= 0 || sample_rate <= 0 || kernel_length <= 0) {
-        fprintf(stderr, "create_fir_filter: One of the input parameters was zero or negative.\n"
-                        "Please ensure that all the input parameters for the filter are non-zero and positive.\n");
-        return NULL;
-    }
-    // Ensure that the kernel length is odd, this enhances the filter efficiency
-    if ((kernel_length & 1) == 0) {
-        kernel_length += 1;
-    }
 
     // Allocate memory for the filter, and check if the allocation was successful
     FIRFilter *filter = (FIRFilter *) malloc(sizeof(FIRFilter));
@@ -164,6 +192,8 @@ FIRFilter *create_fir_filter(
     filter->cutoff_freq = cutoff_freq;
     filter->kernel_length = kernel_length;
     filter->sample_rate = sample_rate;
+    filter->kaiser_beta = kaiser_beta;
+    filter->cutoff_freq_high = cutoff_freq_high;
 
     // Allocate memory for the coefficients, and check if the allocation was successful
     filter->coefficients = (float *) malloc(kernel_length * sizeof(float));
@@ -175,9 +205,142 @@ FIRFilter *create_fir_filter(
 
     // Calculate the filter coefficients
     generate_sinc(filter);
+    detect_fir_filter_structure(filter);
     return filter;
 }
 
+// API endpoint to create a FIR filter
+FIRFilter *create_fir_filter(
+        FilterType type,
+        WindowType window,
+        float cutoff_freq,
+        int kernel_length,
+        float sample_rate
+) {
+    // Validate the input parameters
+    if (cutoff_freq <= 0 || sample_rate <= 0 || kernel_length <= 0) {
+        fprintf(stderr, "create_fir_filter: One of the input parameters was zero or negative.\n"
+                        "Please ensure that all the input parameters for the filter are non-zero and positive.\n");
+        return NULL;
+    }
+    // The beta parameter of the generic Kaiser window comes from the attenuation specification,
+    // and equiripple filters are designed from their band edges
+    if (window == KAISER) {
+        fprintf(stderr, "create_fir_filter: The KAISER window needs a specification, use create_fir_filter_kaiser.\n");
+        return NULL;
+    }
+    if (window == REMEZ) {
+        fprintf(stderr, "create_fir_filter: REMEZ filters are designed by create_fir_filter_remez.\n");
+        return NULL;
+    }
+    if (type == BAND_PASS || type == BAND_STOP) {
+        fprintf(stderr, "create_fir_filter: Band filters have two edges, use create_fir_filter_band.\n");
+        return NULL;
+    }
+    // Ensure that the kernel length is odd, this enhances the filter efficiency
+    if ((kernel_length & 1) == 0) {
+        kernel_length += 1;
+    }
+
+    return design_fir_filter(type, window, fir_kaiser_window_beta(window), cutoff_freq, 0.0f, kernel_length,
+                             sample_rate);
+}
+
+// API endpoint to create a band-pass or band-stop FIR filter
+FIRFilter *create_fir_filter_band(
+        FilterType type,
+        WindowType window,
+        float cutoff_freq_low,
+        float cutoff_freq_high,
+        int kernel_length,
+        float sample_rate
+) {
+    // Validate the input parameters
+    if ((type != BAND_PASS && type != BAND_STOP) || window == KAISER || window == REMEZ || cutoff_freq_low <= 0 ||
+        cutoff_freq_high <= cutoff_freq_low || sample_rate <= 0 || kernel_length <= 0) {
+        fprintf(stderr, "create_fir_filter_band: Invalid input parameter(s).\n");
+        return NULL;
+    }
+    // Ensure that the kernel length is odd, a band-stop filter needs a center tap
+    if ((kernel_length & 1) == 0) {
+        kernel_length += 1;
+    }
+
+    return design_fir_filter(type, window, fir_kaiser_window_beta(window), cutoff_freq_low, cutoff_freq_high,
+                             kernel_length, sample_rate);
+}
+
+// Kaiser's formula for the beta parameter which reaches the stop band attenuation
+float fir_kaiser_beta(float attenuation_db) {
+    if (attenuation_db > 50.0f) {
+        return 0.1102f * (attenuation_db - 8.7f);
+    }
+    if (attenuation_db >= 21.0f) {
+        return 0.5842f * powf(attenuation_db - 21.0f, 0.4f) + 0.07886f * (attenuation_db - 21.0f);
+    }
+    return 0.0f;
+}
+
+// Kaiser's formula for the kernel length which reaches the stop band attenuation within the transition width
+int fir_kaiser_kernel_length(float attenuation_db, float transition_width, float sample_rate) {
+    if (attenuation_db <= 0 || transition_width <= 0 || sample_rate <= 0) {
+        return 0;
+    }
+    // Transition width as an angular frequency in radians per sample
+    double transition_angle = 2.0 * M_PI * (double) transition_width / (double) sample_rate;
+    double kernel_length = ceil(((double) attenuation_db - 8.0) / (2.285 * transition_angle)) + 1.0;
+    if (kernel_length < 3.0) {
+        return 3;
+    }
+    if (kernel_length > (double) (INT_MAX - 1)) {
+        return 0;
+    }
+    int odd_kernel_length = (int) kernel_length;
+    return (odd_kernel_length & 1) ? odd_kernel_length : odd_kernel_length + 1;
+}
+
+// API endpoint to create a FIR filter with a Kaiser window from an attenuation and transition width specification
+FIRFilter *create_fir_filter_kaiser(
+        FilterType type,
+        float cutoff_freq,
+        float attenuation_db,
+        float transition_width,
+        float sample_rate
+) {
+    int kernel_length = fir_kaiser_kernel_length(attenuation_db, transition_width, sample_rate);
+    if ((type != LOW_PASS && type != HIGH_PASS) || cutoff_freq <= 0 || kernel_length <= 0) {
+        fprintf(stderr, "create_fir_filter_kaiser: Invalid input parameter(s).\n");
+        return NULL;
+    }
+    return design_fir_filter(type, KAISER, fir_kaiser_beta(attenuation_db), cutoff_freq, 0.0f, kernel_length,
+                             sample_rate);
+}
+
+// Calculation of the outputs [begin, end) of the flip-and-shift convolution
+void apply_fir_filter_range(
+        const FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int begin,
+        int end
+) {
+    // Calculation of the first kernel_length-1 values of the output
+    // or all of the output values if the kernel is larger than the signal
+    for (int i = begin; i < MIN(filter->kernel_length - 1, end); ++i) {
+        output_signal[i] = 0;
+        for (int j = 0; j < i + 1; ++j) {
+            output_signal[i] += filter->coefficients[j] * input_signal[i - j];
+        }
+    }
+    // Calculation of the rest of output, if the signal is larger than the kernel
+    for (int i = MAX(filter->kernel_length - 1, begin); i < end; ++i) {
+        output_signal[i] = 0;
+        for (int j = 0; j < filter->kernel_length; ++j) {
+            output_signal[i] += filter->coefficients[j] * input_signal[i - j];
+        }
+    }
+}
+
 // API endpoint for applying the filter
 void apply_fir_filter(
         FIRFilter *filter,
@@ -192,30 +355,59 @@ void apply_fir_filter(
         return;
     }
 
-    // For simplicity, the convolution is currently implemented using the flip-and-shift method
-    // instead of the optimal method computation-wise using the Fast Fourier Transform algorithm
+    // This is the reference direct-form (flip-and-shift) engine, whose arithmetic the other engines are tested
+    // against. Long kernels are faster with the FFT engine (apply_fir_filter_fft), and the planner
+    // (fir_plan_engine, apply_fir_filter_planned) picks the fastest engine for a kernel and signal length.
 
     // The last kernel_length-1 values of the convolution are truncated (not calculated),
     // so that the output signal length is equal to the length of the input signal
+    apply_fir_filter_range(filter, input_signal, output_signal, 0, signal_length);
+}
 
-    // The convolution logic
-    // Calculation of the first kernel_length-1 values of the output
-    // or all of the output values if the kernel is larger than the signal
-    for (int i = 0; i < MIN(filter->kernel_length - 1, signal_length); ++i) {
-        output_signal[i] = 0;
-        for (int j = 0; j < i + 1; ++j) {
-            output_signal[i] += filter->coefficients[j] * input_signal[i - j];
+// API endpoint to detect the structure of the filter coefficients
+void detect_fir_filter_structure(FIRFilter *filter) {
+    if (filter == NULL || filter->coefficients == NULL) {
+        return;
+    }
+
+    // The windowed sinc is calculated for n and -n with the same operations, so a designed filter
+    // is exactly symmetric. Only exact symmetry is recorded, so that folding the mirrored input samples
+    // never changes what the filter computes.
+    filter->is_symmetric = 1;
+    for (int n = 0; n < filter->kernel_length / 2; ++n) {
+        if (filter->coefficients[n] != filter->coefficients[filter->kernel_length - 1 - n]) {
+            filter->is_symmetric = 0;
+            break;
         }
     }
-    // Calculation of the rest of output, if the signal is larger than the kernel
-    for (int i = filter->kernel_length - 1; i < signal_length; ++i) {
-        output_signal[i] = 0;
-        for (int j = 0; j < filter->kernel_length; ++j) {
-            output_signal[i] += filter->coefficients[j] * input_signal[i - j];
+
+    // A half-band filter has a sinc zero at every even distance from the center tap, as the normalized
+    // cutoff frequency is one half. The rounding residues of sinf at these points are far below the tolerance.
+    filter->is_half_band = filter->is_symmetric && (filter->kernel_length & 1);
+    int half_M = (filter->kernel_length - 1) / 2;
+    float center = fabsf(filter->coefficients[half_M]);
+    if (center == 0.0f) {
+        filter->is_half_band = 0;
+    }
+    for (int d = 2; filter->is_half_band && d <= half_M; d += 2) {
+        if (fabsf(filter->coefficients[half_M - d]) > HALF_BAND_TOLERANCE * center) {
+            filter->is_half_band = 0;
         }
     }
 }
 
+// API endpoint to zero the structural zero taps of a half-band filter
+void zero_fir_filter_half_band_taps(FIRFilter *filter) {
+    if (filter == NULL || filter->coefficients == NULL || !filter->is_half_band) {
+        return;
+    }
+    int half_M = (filter->kernel_length - 1) / 2;
+    for (int d = 2; d <= half_M; d += 2) {
+        filter->coefficients[half_M - d] = 0.0f;
+        filter->coefficients[half_M + d] = 0.0f;
+    }
+}
+
 // API endpoint to free the memory held by the filter
 void destroy_fir_filter(FIRFilter *filter) {
     if (filter != NULL) {
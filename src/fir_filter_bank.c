@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fir_filter_bank.h"
+#include "fir_filter_internal.h"
+#include "fft.h"
+
+// Number of outputs per block of the direct method. The input window of a block (the block and
+// the kernel_length - 1 samples before it) stays in the cache while all filters are applied to it.
+#define BANK_BLOCK_LENGTH 2048
+
+struct FIRFilterBank {
+    FIRBankMethod method;       // FIR_BANK_DIRECT or FIR_BANK_FFT
+    int filter_count;           // Number of filters
+    FIRFilter *filters;         // Copies of the filters, with their own coefficients
+    int max_kernel_length;      // Length of the longest kernel
+    FFTPlan *fft;               // Shared transform (FFT method only)
+    int fft_size;               // Transform length
+    int block_length;           // New samples per transform
+    float *kernel_spectra;      // Spectra of the zero-padded kernels, fft_size + 2 floats each
+    float *block_spectrum;      // Spectrum of the current input window
+    float *product_spectrum;    // Product of the input and one kernel spectrum
+    float *block;               // Work buffer for the input window and the inverse transform
+};
+
+// Allocate the shared transform and the kernel spectra of the FFT method
+static int init_bank_fft(FIRFilterBank *bank) {
+    // Blocks of several kernel lengths keep the cost of the inverse transforms per output sample low
+    int kernel_length = bank->max_kernel_length;
+    bank->fft_size = fft_next_size(MAX(4 * kernel_length, 1024) + kernel_length - 1);
+    bank->block_length = bank->fft_size - kernel_length + 1;
+
+    int spectrum_length = bank->fft_size + 2;
+    bank->fft = create_fft_plan(bank->fft_size);
+    bank->kernel_spectra = (float *) malloc((size_t) bank->filter_count * spectrum_length * sizeof(float));
+    bank->block_spectrum = (float *) malloc(spectrum_length * sizeof(float));
+    bank->product_spectrum = (float *) malloc(spectrum_length * sizeof(float));
+    bank->block = (float *) malloc(bank->fft_size * sizeof(float));
+    if (bank->fft == NULL || bank->kernel_spectra == NULL || bank->block_spectrum == NULL ||
+        bank->product_spectrum == NULL || bank->block == NULL) {
+        return -1;
+    }
+
+    // Transform every zero-padded kernel once, they are reused by every block of every signal
+    for (int k = 0; k < bank->filter_count; ++k) {
+        const FIRFilter *filter = &bank->filters[k];
+        memcpy(bank->block, filter->coefficients, filter->kernel_length * sizeof(float));
+        memset(bank->block + filter->kernel_length, 0, (bank->fft_size - filter->kernel_length) * sizeof(float));
+        fft_forward(bank->fft, bank->block, bank->kernel_spectra + (size_t) k * spectrum_length);
+    }
+    return 0;
+}
+
+FIRFilterBank *create_fir_filter_bank(FIRFilter *const *filters, int filter_count, FIRBankMethod method) {
+    // Validate the input parameters
+    int valid = filters != NULL && filter_count > 0 &&
+                (method == FIR_BANK_AUTO || method == FIR_BANK_DIRECT || method == FIR_BANK_FFT);
+    for (int k = 0; valid && k < filter_count; ++k) {
+        valid = filters[k] != NULL && filters[k]->coefficients != NULL && filters[k]->kernel_length > 0;
+    }
+    if (!valid) {
+        fprintf(stderr, "create_fir_filter_bank: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFilterBank *bank = (FIRFilterBank *) calloc(1, sizeof(FIRFilterBank));
+    if (bank == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilterBank\n");
+        return NULL;
+    }
+
+    bank->filter_count = filter_count;
+    bank->filters = (FIRFilter *) calloc(filter_count, sizeof(FIRFilter));
+    if (bank->filters == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRFilterBank filters\n");
+        destroy_fir_filter_bank(bank);
+        return NULL;
+    }
+
+    int min_kernel_length = filters[0]->kernel_length;
+    for (int k = 0; k < filter_count; ++k) {
+        bank->filters[k] = *filters[k];
+        bank->filters[k].coefficients = (float *) malloc(filters[k]->kernel_length * sizeof(float));
+        if (bank->filters[k].coefficients == NULL) {
+            fprintf(stderr, "Failed to allocate memory for the FIRFilterBank filters\n");
+            destroy_fir_filter_bank(bank);
+            return NULL;
+        }
+        memcpy(bank->filters[k].coefficients, filters[k]->coefficients, filters[k]->kernel_length * sizeof(float));
+        bank->max_kernel_length = MAX(bank->max_kernel_length, filters[k]->kernel_length);
+        min_kernel_length = MIN(min_kernel_length, filters[k]->kernel_length);
+    }
+
+    // The shared transform pays off when every kernel is long and none of them is padded much
+    if (method == FIR_BANK_AUTO) {
+        method = min_kernel_length >= FIR_BANK_FFT_MIN_LENGTH && bank->max_kernel_length <= 2 * min_kernel_length
+                 ? FIR_BANK_FFT : FIR_BANK_DIRECT;
+    }
+    bank->method = method;
+
+    if (method == FIR_BANK_FFT && init_bank_fft(bank) != 0) {
+        fprintf(stderr, "Failed to allocate memory for the FIRFilterBank buffers\n");
+        destroy_fir_filter_bank(bank);
+        return NULL;
+    }
+    return bank;
+}
+
+FIRBankMethod fir_filter_bank_method(const FIRFilterBank *bank) {
+    return bank != NULL ? bank->method : FIR_BANK_DIRECT;
+}
+
+// Overlap-save with one forward transform per input block, shared by all filters
+static void apply_bank_fft(FIRFilterBank *bank, const float *input_signal, float *const *output_signals,
+                           int signal_length) {
+    int history_length = bank->max_kernel_length - 1;
+    int spectrum_length = bank->fft_size + 2;
+    for (int start = 0; start < signal_length; start += bank->block_length) {
+        // Gather the input window [start - history_length, start + block_length), with zeros before the signal
+        for (int i = 0; i < bank->fft_size; ++i) {
+            int n = start - history_length + i;
+            bank->block[i] = (n >= 0 && n < signal_length) ? input_signal[n] : 0.0f;
+        }
+        fft_forward(bank->fft, bank->block, bank->block_spectrum);
+
+        // The first history_length samples of every circular convolution are aliased and discarded.
+        // Shorter kernels are zero-padded to the longest one, so they are discarded for them as well.
+        int output_count = MIN(bank->block_length, signal_length - start);
+        for (int k = 0; k < bank->filter_count; ++k) {
+            memset(bank->product_spectrum, 0, spectrum_length * sizeof(float));
+            fft_multiply_accumulate(bank->block_spectrum, bank->kernel_spectra + (size_t) k * spectrum_length,
+                                    bank->product_spectrum, bank->fft_size / 2 + 1);
+            fft_inverse(bank->fft, bank->product_spectrum, bank->block);
+            memcpy(output_signals[k] + start, bank->block + history_length, output_count * sizeof(float));
+        }
+    }
+}
+
+// API endpoint for applying all filters of the bank in one pass over the input
+void apply_fir_filter_bank(
+        FIRFilterBank *bank,
+        const float *input_signal,
+        float *const *output_signals,
+        int signal_length
+) {
+    // Check for valid input parameters
+    int valid = bank != NULL && input_signal != NULL && output_signals != NULL && signal_length >= 0;
+    for (int k = 0; valid && k < bank->filter_count; ++k) {
+        valid = output_signals[k] != NULL;
+    }
+    if (!valid) {
+        fprintf(stderr, "apply_fir_filter_bank: Invalid input parameter(s).\n");
+        return;
+    }
+
+    if (bank->method == FIR_BANK_FFT) {
+        apply_bank_fft(bank, input_signal, output_signals, signal_length);
+        return;
+    }
+
+    // Every block is filtered by all filters before moving on to the next one
+    FIRSimdLevel level = fir_simd_detect();
+    for (int start = 0; start < signal_length; start += BANK_BLOCK_LENGTH) {
+        int end = MIN(start + BANK_BLOCK_LENGTH, signal_length);
+        for (int k = 0; k < bank->filter_count; ++k) {
+            apply_fir_filter_simd_range(level, &bank->filters[k], input_signal, output_signals[k], start, end);
+        }
+    }
+}
+
+// API endpoint to free the memory held by the bank
+void destroy_fir_filter_bank(FIRFilterBank *bank) {
+    if (bank != NULL) {
+        if (bank->filters != NULL) {
+            for (int k = 0; k < bank->filter_count; ++k) {
+                free(bank->filters[k].coefficients);
+            }
+            free(bank->filters);
+        }
+        destroy_fft_plan(bank->fft);
+        free(bank->kernel_spectra);
+        free(bank->block_spectrum);
+        free(bank->product_spectrum);
+        free(bank->block);
+        free(bank);
+    }
+}
@@ -2,30 +2,62 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
 #include "fir_filter_cli.h"
 #include "fir_filter.h"
+#include "fir_filter_simd.h"
+#include "fir_multirate.h"
+#include "fir_multichannel.h"
+#include "fir_complex.h"
+#include "fir_planner.h"
+#include "fir_fixed_point.h"
+
+// Largest number of columns (channels) of an input signal file
+#define MAX_CHANNEL_COUNT 1024
+// Longest line of an input signal file, MAX_CHANNEL_COUNT columns of up to 32 characters each
+#define MAX_LINE_LENGTH (MAX_CHANNEL_COUNT * 32)
 
 
 void print_usage(const char *prog_name) {
     printf("Usage:\n");
     printf("  %s create <filter_type> <window_type> <cutoff_freq> <kernel_length> <sample_rate> <output_file>\n", prog_name);
+    printf("  %s create_kaiser <filter_type> <cutoff_freq> <attenuation> <transition> <sample_rate> <output_file>\n", prog_name);
     printf("  %s apply <input_file> <filter_file> <output_file>\n", prog_name);
+    printf("  %s decimate <input_file> <filter_file> <factor> <output_file>\n", prog_name);
+    printf("  %s interpolate <input_file> <filter_file> <factor> <output_file>\n", prog_name);
+    printf("  %s resample <input_file> <up_factor> <down_factor> <window_type> <output_file>\n", prog_name);
+    printf("  %s apply_q15 <input_raw> <filter_file> <output_raw>\n", prog_name);
+    printf("  %s calibrate [wisdom_file]\n", prog_name);
     printf("  %s destroy <filter_file>\n", prog_name);
     printf("\n");
     printf("Commands:\n");
-    printf("  create    Create a FIR filter and save it to a file\n");
-    printf("  apply     Apply a FIR filter to an input signal\n");
-    printf("  destroy   Destroy a FIR filter (delete the filter file)\n");
+    printf("  create      Create a FIR filter and save it to a file\n");
+    printf("  create_kaiser Create the shortest Kaiser window FIR filter which meets the specification\n");
+    printf("  apply       Apply a FIR filter to an input signal\n");
+    printf("  decimate    Apply a FIR filter and keep every factor-th output sample\n");
+    printf("  interpolate Upsample an input signal by a factor and apply a FIR filter\n");
+    printf("  resample    Change the sample rate of an input signal by up_factor / down_factor\n");
+    printf("  apply_q15   Apply a FIR filter in Q15 fixed point to a raw int16 signal\n");
+    printf("  calibrate   Time the convolution engines on this machine and save the wisdom used by apply\n");
+    printf("  destroy     Destroy a FIR filter (delete the filter file)\n");
     printf("\n");
     printf("Options:\n");
-    printf("  <filter_type>   : lowpass or highpass\n");
+    printf("  <filter_type>   : lowpass, highpass, bandpass or bandstop\n");
     printf("  <window_type>   : rect, hanning, hamming, blackman, kaiser_b6, kaiser_b8, kaiser_b10\n");
-    printf("  <cutoff_freq>   : Cutoff frequency in Hz\n");
+    printf("  <cutoff_freq>   : Cutoff frequency in Hz, or <low>:<high> band edges in Hz for bandpass and bandstop\n");
     printf("  <kernel_length> : Kernel length (odd integer)\n");
     printf("  <sample_rate>   : Sample rate in Hz\n");
-    printf("  <input_file>    : Path to input signal file (text file with one float per line)\n");
+    printf("  <attenuation>   : Stop band attenuation in dB\n");
+    printf("  <transition>    : Width of the transition band around the cutoff frequency in Hz\n");
+    printf("  <factor>        : Decimation or interpolation factor (positive integer)\n");
+    printf("  <up_factor>     : Resampling numerator, e.g. the output sample rate (positive integer)\n");
+    printf("  <down_factor>   : Resampling denominator, e.g. the input sample rate (positive integer)\n");
+    printf("  <input_file>    : Path to input signal file (text file with one float per line,\n");
+    printf("                    for apply also one frame of several channels per line, e.g. I and Q)\n");
     printf("  <output_file>   : Path to output signal file (text file with one float per line)\n");
     printf("  <filter_file>   : Path to filter file (binary file to save/load the filter)\n");
+    printf("  <input_raw>     : Path to input signal file (raw native-endian int16 samples)\n");
+    printf("  <output_raw>    : Path to output signal file (raw native-endian int16 samples)\n");
 }
 
 // Below are CLI argument parser functions
@@ -33,6 +65,8 @@ void print_usage(const char *prog_name) {
 static FilterType parse_filter_type(const char *arg) {
     if (strcmp(arg, "lowpass") == 0) return LOW_PASS;
     if (strcmp(arg, "highpass") == 0) return HIGH_PASS;
+    if (strcmp(arg, "bandpass") == 0) return BAND_PASS;
+    if (strcmp(arg, "bandstop") == 0) return BAND_STOP;
     fprintf(stderr, "Invalid filter type: %s\n", arg);
     exit(EXIT_FAILURE);
 }
@@ -62,6 +96,24 @@ static float parse_cutoff_freq(const char *arg) {
     }
 }
 
+// Parse the band edges of a band filter, given as <low>:<high>
+static void parse_band_edges(const char *arg, float *cutoff_freq_low, float *cutoff_freq_high) {
+    char *endptr;
+    errno = 0;
+
+    *cutoff_freq_low = strtof(arg, &endptr);
+    if (errno != 0 || endptr == arg || *endptr != ':') {
+        fprintf(stderr, "Invalid band edges (expected <low>:<high>): %s\n", arg);
+        exit(EXIT_FAILURE);
+    }
+    const char *high_arg = endptr + 1;
+    *cutoff_freq_high = strtof(high_arg, &endptr);
+    if (errno != 0 || endptr == high_arg) {
+        fprintf(stderr, "Invalid band edges (expected <low>:<high>): %s\n", arg);
+        exit(EXIT_FAILURE);
+    }
+}
+
 static int parse_kernel_length(const char *arg) {
     char *endptr;
     errno = 0;
@@ -88,6 +140,46 @@ static float parse_sample_rate(const char *arg) {
     }
 }
 
+static float parse_attenuation(const char *arg) {
+    char *endptr;
+    errno = 0;
+
+    float attenuation_db = strtof(arg, &endptr);
+    if (errno != 0 || endptr == arg || attenuation_db <= 0) {
+        fprintf(stderr, "Invalid attenuation: %s\n", arg);
+        exit(EXIT_FAILURE);
+    } else {
+        return attenuation_db;
+    }
+}
+
+static float parse_transition_width(const char *arg) {
+    char *endptr;
+    errno = 0;
+
+    float transition_width = strtof(arg, &endptr);
+    if (errno != 0 || endptr == arg || transition_width <= 0) {
+        fprintf(stderr, "Invalid transition width: %s\n", arg);
+        exit(EXIT_FAILURE);
+    } else {
+        return transition_width;
+    }
+}
+
+static int parse_factor(const char *arg) {
+    char *endptr;
+    errno = 0;
+
+    // Parse in long first, so values outside of int are rejected instead of truncated
+    long factor = strtol(arg, &endptr, 10);
+    if (errno == ERANGE || endptr == arg || factor <= 0 || factor > INT_MAX) {
+        fprintf(stderr, "Invalid factor: %s\n", arg);
+        exit(EXIT_FAILURE);
+    } else {
+        return (int) factor;
+    }
+}
+
 // Save the filter data into a binary file to be reused later
 static void save_filter_to_file(const char *filename, FIRFilter *filter) {
     FILE *file = fopen(filename, "wb");
@@ -102,6 +194,9 @@ static void save_filter_to_file(const char *filename, FIRFilter *filter) {
     fwrite(&filter->kernel_length, sizeof(int), 1, file);
     fwrite(&filter->sample_rate, sizeof(float), 1, file);
     fwrite(filter->coefficients, sizeof(float), filter->kernel_length, file);
+    // Fields added after the original format are appended, so that older filter files can still be loaded
+    fwrite(&filter->kaiser_beta, sizeof(float), 1, file);
+    fwrite(&filter->cutoff_freq_high, sizeof(float), 1, file);
 
     fclose(file);
 }
@@ -136,13 +231,28 @@ static FIRFilter *load_filter_from_file(const char *filename) {
     }
 
     fread(filter->coefficients, sizeof(float), filter->kernel_length, file);
+    // Filter files written before the Kaiser beta and the upper band edge were appended end after the coefficients
+    if (fread(&filter->kaiser_beta, sizeof(float), 1, file) != 1) {
+        filter->kaiser_beta = 0.0f;
+    }
+    if (fread(&filter->cutoff_freq_high, sizeof(float), 1, file) != 1) {
+        filter->cutoff_freq_high = 0.0f;
+    }
+    detect_fir_filter_structure(filter);
 
     fclose(file);
     return filter;
 }
 
-// Read the input signal from the text input file
-static float *read_signal_from_file(const char *filename, int *length) {
+// Path of the planner wisdom file, from the FIR_FILTER_WISDOM environment variable or the default path
+static const char *wisdom_file_path(void) {
+    const char *path = getenv("FIR_FILTER_WISDOM");
+    return (path != NULL && path[0] != '\0') ? path : FIR_DEFAULT_WISDOM_FILE;
+}
+
+// Read a multi-channel input signal from the text input file, one frame per line with the samples
+// of the channels separated by whitespace or commas. The samples are returned interleaved.
+static float *read_channels_from_file(const char *filename, int *frame_count, int *channel_count) {
     FILE *file = fopen(filename, "r");
     if (file == NULL) {
         fprintf(stderr, "Failed to open input file: %s\n", filename);
@@ -151,26 +261,59 @@ static float *read_signal_from_file(const char *filename, int *length) {
 
     float *signal = NULL;
     int count = 0;
-    char line[256];
+    int channels = 0;
+    char line[MAX_LINE_LENGTH];
 
     // Loop to read each line from the file
     while (fgets(line, sizeof(line), file)) {
-        char *endptr;
-        errno = 0;
-
-        // Convert the line to a float
-        float value = strtof(line, &endptr);
+        // A line without its newline before the end of the file did not fit into the buffer
+        if (strchr(line, '\n') == NULL && !feof(file)) {
+            fprintf(stderr, "Line longer than %d characters in input file: %s\n", MAX_LINE_LENGTH - 2, filename);
+            free(signal);
+            fclose(file);
+            exit(EXIT_FAILURE);
+        }
+        float frame[MAX_CHANNEL_COUNT];
+        int columns = 0;
+        char *cursor = line;
+
+        // Convert the columns of the line to floats
+        while (1) {
+            while (*cursor == ' ' || *cursor == '\t' || *cursor == ',') {
+                ++cursor;
+            }
+            if (*cursor == '\n' || *cursor == '\r' || *cursor == '\0') {
+                break;
+            }
+
+            char *endptr;
+            errno = 0;
+            float value = strtof(cursor, &endptr);
+
+            // Check for conversion errors
+            if (errno != 0 || endptr == cursor || columns == MAX_CHANNEL_COUNT ||
+                (*endptr != ' ' && *endptr != '\t' && *endptr != ',' && *endptr != '\n' && *endptr != '\r' &&
+                 *endptr != '\0')) {
+                fprintf(stderr, "Invalid float value in input file: %s", line);
+                free(signal);
+                fclose(file);
+                exit(EXIT_FAILURE);
+            }
+            frame[columns++] = value;
+            cursor = endptr;
+        }
 
-        // Check for conversion errors
-        if (errno != 0 || endptr == line || (*endptr != '\n' && *endptr != '\0' && *endptr != '\r')) {
-            fprintf(stderr, "Invalid float value in input file: %s", line);
+        // Every frame needs a sample of every channel
+        if (columns == 0 || (channels != 0 && columns != channels)) {
+            fprintf(stderr, "Invalid number of columns in input file: %s", line);
             free(signal);
             fclose(file);
             exit(EXIT_FAILURE);
         }
+        channels = columns;
 
-        // Reallocate memory to store the new float value
-        float *temp = realloc(signal, (count + 1) * sizeof(float));
+        // Reallocate memory to store the new frame
+        float *temp = realloc(signal, (size_t) (count + 1) * channels * sizeof(float));
         if (temp == NULL) {
             fprintf(stderr, "Memory allocation failed while reading input signal\n");
             free(signal);
@@ -178,27 +321,90 @@ static float *read_signal_from_file(const char *filename, int *length) {
             exit(EXIT_FAILURE);
         }
         signal = temp;
-        signal[count++] = value;
+        memcpy(signal + (size_t) count * channels, frame, channels * sizeof(float));
+        ++count;
     }
 
     fclose(file);
-    *length = count;
+    *frame_count = count;
+    *channel_count = channels > 0 ? channels : 1;
     return signal;
 }
 
-// Write the calculated signal to the text output file
-static void write_signal_to_file(const char *filename, const float *signal, int length) {
+// Read the single-channel input signal from the text input file
+static float *read_signal_from_file(const char *filename, int *length) {
+    int channel_count;
+    float *signal = read_channels_from_file(filename, length, &channel_count);
+    if (channel_count != 1) {
+        fprintf(stderr, "Expected a single-channel input file: %s\n", filename);
+        free(signal);
+        exit(EXIT_FAILURE);
+    }
+    return signal;
+}
+
+// Write the calculated interleaved multi-channel signal to the text output file, one frame per line
+static void write_channels_to_file(const char *filename, const float *signal, int frame_count, int channel_count) {
     FILE *file = fopen(filename, "w");
     if (file == NULL) {
         fprintf(stderr, "Failed to open output file: %s\n", filename);
         exit(EXIT_FAILURE);
     }
 
-    for (int i = 0; i < length; ++i) {
-        fprintf(file, "%f\n", signal[i]);
+    for (int i = 0; i < frame_count; ++i) {
+        for (int c = 0; c < channel_count; ++c) {
+            fprintf(file, c + 1 < channel_count ? "%f " : "%f\n", signal[(size_t) i * channel_count + c]);
+        }
+    }
+
+    fclose(file);
+}
+
+// Write the calculated signal to the text output file
+static void write_signal_to_file(const char *filename, const float *signal, int length) {
+    write_channels_to_file(filename, signal, length, 1);
+}
+
+
+// Read a raw file of native-endian int16 samples
+static int16_t *read_raw_int16_from_file(const char *filename, int *length) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open input file: %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    *length = (int) (size / (long) sizeof(int16_t));
+
+    int16_t *signal = (int16_t *) malloc((*length > 0 ? *length : 1) * sizeof(int16_t));
+    if (signal == NULL) {
+        fprintf(stderr, "Memory allocation failed for input signal\n");
+        fclose(file);
+        exit(EXIT_FAILURE);
+    }
+    if (fread(signal, sizeof(int16_t), *length, file) != (size_t) *length) {
+        fprintf(stderr, "Failed to read input file: %s\n", filename);
+        free(signal);
+        fclose(file);
+        exit(EXIT_FAILURE);
     }
 
     fclose(file);
+    return signal;
+}
+
+// Write the calculated signal to a raw file of native-endian int16 samples
+static void write_raw_int16_to_file(const char *filename, const int16_t *signal, int length) {
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open output file: %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    fwrite(signal, sizeof(int16_t), length, file);
+    fclose(file);
 }
 
 
@@ -210,16 +416,50 @@ void handle_create_fir_filter(int argc, char *argv[]) {
 
     FilterType filter_type = parse_filter_type(argv[2]);
     WindowType window_type = parse_window_type(argv[3]);
-    float cutoff_freq = parse_cutoff_freq(argv[4]);
     int kernel_length = parse_kernel_length(argv[5]);
     float sample_rate = parse_sample_rate(argv[6]);
     const char *output_file = argv[7];
 
-    FIRFilter *filter = create_fir_filter(filter_type, window_type, cutoff_freq, kernel_length, sample_rate);
+    FIRFilter *filter;
+    if (filter_type == BAND_PASS || filter_type == BAND_STOP) {
+        float cutoff_freq_low, cutoff_freq_high;
+        parse_band_edges(argv[4], &cutoff_freq_low, &cutoff_freq_high);
+        filter = create_fir_filter_band(filter_type, window_type, cutoff_freq_low, cutoff_freq_high, kernel_length,
+                                        sample_rate);
+    } else {
+        float cutoff_freq = parse_cutoff_freq(argv[4]);
+        filter = create_fir_filter(filter_type, window_type, cutoff_freq, kernel_length, sample_rate);
+    }
+    if (filter == NULL) {
+        fprintf(stderr, "Failed to create FIR filter\n");
+        exit(EXIT_FAILURE);
+    }
+
+    save_filter_to_file(output_file, filter);
+    destroy_fir_filter(filter);
+}
+
+
+void handle_create_kaiser_fir_filter(int argc, char *argv[]) {
+    if (argc != 8) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    FilterType filter_type = parse_filter_type(argv[2]);
+    float cutoff_freq = parse_cutoff_freq(argv[3]);
+    float attenuation_db = parse_attenuation(argv[4]);
+    float transition_width = parse_transition_width(argv[5]);
+    float sample_rate = parse_sample_rate(argv[6]);
+    const char *output_file = argv[7];
+
+    FIRFilter *filter = create_fir_filter_kaiser(filter_type, cutoff_freq, attenuation_db, transition_width,
+                                                 sample_rate);
     if (filter == NULL) {
         fprintf(stderr, "Failed to create FIR filter\n");
         exit(EXIT_FAILURE);
     }
+    printf("Kaiser window beta: %g, kernel length: %d\n", filter->kaiser_beta, filter->kernel_length);
 
     save_filter_to_file(output_file, filter);
     destroy_fir_filter(filter);
@@ -236,9 +476,54 @@ void handle_apply_fir_filter(int argc, char *argv[]) {
     const char *filter_file = argv[3];
     const char *output_file = argv[4];
 
+    int signal_length;
+    int channel_count;
+    float *input_signal = read_channels_from_file(input_file, &signal_length, &channel_count);
+    float *output_signal = (float *) malloc((size_t) signal_length * channel_count * sizeof(float));
+    if (!output_signal) {
+        fprintf(stderr, "Memory allocation failed for output signal\n");
+        free(input_signal);
+        exit(EXIT_FAILURE);
+    }
+
+    FIRFilter *filter = load_filter_from_file(filter_file);
+
+    // Multi-column files are filtered column by column, in one sweep over the interleaved frames.
+    // Two columns are I/Q pairs, whose interleaved samples the complex engine vectorizes along time.
+    // A single column is filtered with the engine the planner picks, with the wisdom of this machine if available.
+    if (channel_count == 1) {
+        fir_planner_load_wisdom(wisdom_file_path());
+        apply_fir_filter_planned(filter, input_signal, output_signal, signal_length, FIR_LATENCY_UNBOUNDED);
+    } else if (channel_count == 2) {
+        apply_fir_filter_complex(filter, input_signal, output_signal, signal_length);
+    } else {
+        apply_fir_filter_multichannel(filter, input_signal, output_signal, signal_length, channel_count,
+                                      FIR_LAYOUT_INTERLEAVED);
+    }
+    write_channels_to_file(output_file, output_signal, signal_length, channel_count);
+
+    // Free all the memory held up by the dynamically allocated memory
+    free(input_signal);
+    free(output_signal);
+    destroy_fir_filter(filter);
+}
+
+
+void handle_decimate_fir_filter(int argc, char *argv[]) {
+    if (argc != 6) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *input_file = argv[2];
+    const char *filter_file = argv[3];
+    int factor = parse_factor(argv[4]);
+    const char *output_file = argv[5];
+
     int signal_length;
     float *input_signal = read_signal_from_file(input_file, &signal_length);
-    float *output_signal = (float *) malloc(signal_length * sizeof(float));
+    int output_length = fir_decimated_length(signal_length, factor);
+    float *output_signal = (float *) malloc((output_length > 0 ? output_length : 1) * sizeof(float));
     if (!output_signal) {
         fprintf(stderr, "Memory allocation failed for output signal\n");
         free(input_signal);
@@ -247,8 +532,14 @@ void handle_apply_fir_filter(int argc, char *argv[]) {
 
     FIRFilter *filter = load_filter_from_file(filter_file);
 
-    apply_fir_filter(filter, input_signal, output_signal, signal_length);
-    write_signal_to_file(output_file, output_signal, signal_length);
+    if (apply_fir_decimate(filter, input_signal, output_signal, signal_length, factor) != 0) {
+        fprintf(stderr, "Failed to decimate the signal\n");
+        free(input_signal);
+        free(output_signal);
+        destroy_fir_filter(filter);
+        exit(EXIT_FAILURE);
+    }
+    write_signal_to_file(output_file, output_signal, output_length);
 
     // Free all the memory held up by the dynamically allocated memory
     free(input_signal);
@@ -257,6 +548,145 @@ void handle_apply_fir_filter(int argc, char *argv[]) {
 }
 
 
+void handle_interpolate_fir_filter(int argc, char *argv[]) {
+    if (argc != 6) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *input_file = argv[2];
+    const char *filter_file = argv[3];
+    int factor = parse_factor(argv[4]);
+    const char *output_file = argv[5];
+
+    int signal_length;
+    float *input_signal = read_signal_from_file(input_file, &signal_length);
+    if (signal_length > 0 && factor > INT_MAX / signal_length) {
+        fprintf(stderr, "Interpolation factor %d is too large for a signal of %d samples\n", factor, signal_length);
+        free(input_signal);
+        exit(EXIT_FAILURE);
+    }
+    int output_length = signal_length * factor;
+    float *output_signal = (float *) malloc((output_length > 0 ? (size_t) signal_length * factor : 1) * sizeof(float));
+    if (!output_signal) {
+        fprintf(stderr, "Memory allocation failed for output signal\n");
+        free(input_signal);
+        exit(EXIT_FAILURE);
+    }
+
+    FIRFilter *filter = load_filter_from_file(filter_file);
+
+    if (apply_fir_interpolate(filter, input_signal, output_signal, signal_length, factor) != 0) {
+        fprintf(stderr, "Failed to interpolate the signal\n");
+        free(input_signal);
+        free(output_signal);
+        destroy_fir_filter(filter);
+        exit(EXIT_FAILURE);
+    }
+    // Restore the amplitude lost to the zero stuffing
+    for (int i = 0; i < output_length; ++i) {
+        output_signal[i] *= (float) factor;
+    }
+    write_signal_to_file(output_file, output_signal, output_length);
+
+    // Free all the memory held up by the dynamically allocated memory
+    free(input_signal);
+    free(output_signal);
+    destroy_fir_filter(filter);
+}
+
+
+void handle_resample_signal(int argc, char *argv[]) {
+    if (argc != 7) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *input_file = argv[2];
+    int up_factor = parse_factor(argv[3]);
+    int down_factor = parse_factor(argv[4]);
+    WindowType window_type = parse_window_type(argv[5]);
+    const char *output_file = argv[6];
+
+    FIRResampler *resampler = create_fir_resampler(up_factor, down_factor, window_type, 0);
+    if (resampler == NULL) {
+        fprintf(stderr, "Failed to create the resampler\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int signal_length;
+    float *input_signal = read_signal_from_file(input_file, &signal_length);
+    int output_length = fir_resampler_max_output_length(resampler, signal_length);
+    float *output_signal = (float *) malloc((output_length > 0 ? output_length : 1) * sizeof(float));
+    if (!output_signal) {
+        fprintf(stderr, "Memory allocation failed for output signal\n");
+        free(input_signal);
+        destroy_fir_resampler(resampler);
+        exit(EXIT_FAILURE);
+    }
+
+    output_length = process_fir_resampler(resampler, input_signal, signal_length, output_signal);
+    write_signal_to_file(output_file, output_signal, output_length);
+
+    // Free all the memory held up by the dynamically allocated memory
+    free(input_signal);
+    free(output_signal);
+    destroy_fir_resampler(resampler);
+}
+
+
+void handle_apply_q15_fir_filter(int argc, char *argv[]) {
+    if (argc != 5) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *input_file = argv[2];
+    const char *filter_file = argv[3];
+    const char *output_file = argv[4];
+
+    FIRFilter *filter = load_filter_from_file(filter_file);
+    FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+    destroy_fir_filter(filter);
+    if (quantized == NULL) {
+        exit(EXIT_FAILURE);
+    }
+
+    int signal_length;
+    int16_t *input_signal = read_raw_int16_from_file(input_file, &signal_length);
+    int16_t *output_signal = (int16_t *) malloc((signal_length > 0 ? signal_length : 1) * sizeof(int16_t));
+    if (!output_signal) {
+        fprintf(stderr, "Memory allocation failed for output signal\n");
+        free(input_signal);
+        destroy_fir_filter_q15(quantized);
+        exit(EXIT_FAILURE);
+    }
+
+    apply_fir_filter_q15(quantized, input_signal, output_signal, signal_length);
+    write_raw_int16_to_file(output_file, output_signal, signal_length);
+
+    // Free all the memory held up by the dynamically allocated memory
+    free(input_signal);
+    free(output_signal);
+    destroy_fir_filter_q15(quantized);
+}
+
+
+void handle_calibrate_planner(int argc, char *argv[]) {
+    if (argc != 2 && argc != 3) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    const char *wisdom_file = argc == 3 ? argv[2] : wisdom_file_path();
+    fir_planner_calibrate();
+    if (fir_planner_save_wisdom(wisdom_file) != 0) {
+        exit(EXIT_FAILURE);
+    }
+    printf("Saved the wisdom for %s to %s\n", fir_simd_level_name(fir_simd_detect()), wisdom_file);
+}
+
+
 void handle_destroy_fir_filter(int argc, char *argv[]) {
     if (argc != 3) {
         print_usage(argv[0]);
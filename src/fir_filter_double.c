@@ -0,0 +1,419 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fir_filter_double.h"
+#include "fir_filter_internal.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Modified zero order Bessel function of the 1st kind, I0(x), as a power series whose terms
+// ((x/2)^k / k!)^2 are obtained from the previous term, summed until they no longer change the result
+static double I0_double(double x) {
+    double quarter_x_squared = x * x / 4.0;
+    double term = 1.0;
+    double result = 1.0;
+    for (int k = 1; term > result * 1e-17; ++k) {
+        term *= quarter_x_squared / ((double) k * (double) k);
+        result += term;
+    }
+    return result;
+}
+
+// Calculate the window function term based on the window type
+static double window_function_double(WindowType window, double beta_param, double I0_beta, int kernel_length, int n) {
+    // Normalized angular position: (2 * pi * n) / (N - 1)
+    double normalized_ang_pos = 2.0 * M_PI * (double) n / (double) (kernel_length - 1);
+    switch (window) {
+        case RECT:
+            return 1.0;
+        case HANNING:
+            return 0.5 + 0.5 * cos(normalized_ang_pos);
+        case HAMMING:
+            return 0.54 + 0.46 * cos(normalized_ang_pos);
+        case BLACKMAN:
+            return 0.42 + 0.5 * cos(normalized_ang_pos) + 0.08 * cos(2.0 * normalized_ang_pos);
+        case KAISER_B6:
+        case KAISER_B8:
+        case KAISER_B10: {
+            // Normalized window position: (2 * n) / (N - 1)
+            double normalized_win_pos = 2.0 * (double) n / (double) (kernel_length - 1);
+            return I0_double(beta_param * sqrt(1.0 - normalized_win_pos * normalized_win_pos)) / I0_beta;
+        }
+        default:
+            return 1.0;
+    }
+}
+
+// Calculate the coefficients for the filter, as generate_sinc does in single precision
+static void generate_sinc_double(FIRFilterDouble *filter) {
+    double normalized_cutoff_freq = 2.0 * filter->cutoff_freq / filter->sample_rate;
+    int half_M = (filter->kernel_length - 1) / 2;
+
+    double beta_param = (double) fir_kaiser_window_beta(filter->window);
+    double I0_beta = I0_double(beta_param);
+
+    for (int n = -half_M; n <= half_M; ++n) {
+        double *coefficient_ptr = filter->coefficients + n + half_M;
+        double pi_times_n = M_PI * (double) n;
+
+        // Pure sinc function, h[n] = sin(wc * pi * n) / (pi * n)
+        if (n == 0) {
+            *coefficient_ptr = normalized_cutoff_freq;
+        } else {
+            *coefficient_ptr = sin(normalized_cutoff_freq * pi_times_n) / pi_times_n;
+        }
+        *coefficient_ptr *= window_function_double(filter->window, beta_param, I0_beta, filter->kernel_length, n);
+
+        // Spectral inversion for the high-pass filter
+        if (filter->type == HIGH_PASS) {
+            *coefficient_ptr *= -1;
+            if (n == 0) *coefficient_ptr += 1;
+        }
+    }
+}
+
+// API endpoint to create a double-precision FIR filter
+FIRFilterDouble *create_fir_filter_double(
+        FilterType type,
+        WindowType window,
+        double cutoff_freq,
+        int kernel_length,
+        double sample_rate
+) {
+    // Validate the input parameters
+    if (cutoff_freq <= 0 || sample_rate <= 0 || kernel_length <= 0) {
+        fprintf(stderr, "create_fir_filter_double: One of the input parameters was zero or negative.\n"
+                        "Please ensure that all the input parameters for the filter are non-zero and positive.\n");
+        return NULL;
+    }
+    if (type == BAND_PASS || type == BAND_STOP) {
+        fprintf(stderr, "create_fir_filter_double: Band filters are designed in single precision by "
+                        "create_fir_filter_band.\n");
+        return NULL;
+    }
+    if (window == KAISER || window == REMEZ) {
+        fprintf(stderr, "create_fir_filter_double: The KAISER and REMEZ designs need a specification, "
+                        "use create_fir_filter_kaiser or create_fir_filter_remez.\n");
+        return NULL;
+    }
+    // Ensure that the kernel length is odd, like create_fir_filter
+    if ((kernel_length & 1) == 0) {
+        kernel_length += 1;
+    }
+
+    FIRFilterDouble *filter = (FIRFilterDouble *) malloc(sizeof(FIRFilterDouble));
+    if (filter == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilterDouble\n");
+        return NULL;
+    }
+    filter->type = type;
+    filter->window = window;
+    filter->cutoff_freq = cutoff_freq;
+    filter->kernel_length = kernel_length;
+    filter->sample_rate = sample_rate;
+    filter->coefficients = (double *) malloc(kernel_length * sizeof(double));
+    if (filter->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the filter\n");
+        free(filter);
+        return NULL;
+    }
+
+    generate_sinc_double(filter);
+
+    // The design evaluates n and -n with the same operations, so only exact symmetry is recorded
+    filter->is_symmetric = 1;
+    for (int n = 0; n < kernel_length / 2; ++n) {
+        if (filter->coefficients[n] != filter->coefficients[kernel_length - 1 - n]) {
+            filter->is_symmetric = 0;
+            break;
+        }
+    }
+    return filter;
+}
+
+// API endpoint to round a double-precision design to a float filter
+FIRFilter *convert_fir_filter_double_to_float(const FIRFilterDouble *filter) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0) {
+        fprintf(stderr, "convert_fir_filter_double_to_float: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFilter *converted = (FIRFilter *) malloc(sizeof(FIRFilter));
+    if (converted == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilter\n");
+        return NULL;
+    }
+    converted->type = filter->type;
+    converted->window = filter->window;
+    converted->cutoff_freq = (float) filter->cutoff_freq;
+    converted->kernel_length = filter->kernel_length;
+    converted->sample_rate = (float) filter->sample_rate;
+    converted->kaiser_beta = fir_kaiser_window_beta(filter->window);
+    converted->cutoff_freq_high = 0.0f;
+    converted->coefficients = (float *) malloc(filter->kernel_length * sizeof(float));
+    if (converted->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the filter\n");
+        free(converted);
+        return NULL;
+    }
+    for (int j = 0; j < filter->kernel_length; ++j) {
+        converted->coefficients[j] = (float) filter->coefficients[j];
+    }
+    detect_fir_filter_structure(converted);
+    return converted;
+}
+
+// Every kernel computes the outputs [begin, end), for which the full kernel overlaps the signal,
+// with the block structure of the float kernels in fir_filter_simd.c
+typedef void (*DoubleKernel)(const double *coefficients, int kernel_length, const double *input, double *output,
+                             int begin, int end);
+
+static void direct_kernel_scalar(const double *coefficients, int kernel_length, const double *input, double *output,
+                                 int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum += coefficients[j] * input[i - j];
+        }
+        output[i] = sum;
+    }
+}
+
+// Symmetric kernels are folded: the two input samples which meet the same coefficient are added first
+static void folded_kernel_scalar(const double *coefficients, int kernel_length, const double *input, double *output,
+                                 int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    for (int i = begin; i < end; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < half; ++j) {
+            sum += coefficients[j] * (input[i - j] + input[i - last + j]);
+        }
+        if (kernel_length & 1) {
+            sum += coefficients[half] * input[i - half];
+        }
+        output[i] = sum;
+    }
+}
+
+#if FIR_SIMD_X86
+
+// Scalar remainders of the FMA kernels, with the same per-output arithmetic as the vector lanes
+__attribute__((target("avx2,fma")))
+static void direct_kernel_tail_fma(const double *coefficients, int kernel_length, const double *input, double *output,
+                                   int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum = fma(coefficients[j], input[i - j], sum);
+        }
+        output[i] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_tail_fma(const double *coefficients, int kernel_length, const double *input, double *output,
+                                   int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    for (int i = begin; i < end; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < half; ++j) {
+            sum = fma(coefficients[j], input[i - j] + input[i - last + j], sum);
+        }
+        if (kernel_length & 1) {
+            sum = fma(coefficients[half], input[i - half], sum);
+        }
+        output[i] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void direct_kernel_avx2(const double *coefficients, int kernel_length, const double *input, double *output,
+                               int begin, int end) {
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+        for (int j = 0; j < kernel_length; ++j) {
+            const double *x = input + i - j;
+            __m256d h = _mm256_broadcast_sd(coefficients + j);
+            acc0 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x), acc0);
+            acc1 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 4), acc1);
+            acc2 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 8), acc2);
+            acc3 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 12), acc3);
+        }
+        _mm256_storeu_pd(output + i, acc0);
+        _mm256_storeu_pd(output + i + 4, acc1);
+        _mm256_storeu_pd(output + i + 8, acc2);
+        _mm256_storeu_pd(output + i + 12, acc3);
+    }
+    for (; i + 4 <= end; i += 4) {
+        __m256d acc = _mm256_setzero_pd();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm256_fmadd_pd(_mm256_broadcast_sd(coefficients + j), _mm256_loadu_pd(input + i - j), acc);
+        }
+        _mm256_storeu_pd(output + i, acc);
+    }
+    direct_kernel_tail_fma(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_avx2(const double *coefficients, int kernel_length, const double *input, double *output,
+                               int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+        for (int j = 0; j < half; ++j) {
+            const double *x = input + i - j;
+            const double *m = input + i - last + j;
+            __m256d h = _mm256_broadcast_sd(coefficients + j);
+            acc0 = _mm256_fmadd_pd(h, _mm256_add_pd(_mm256_loadu_pd(x), _mm256_loadu_pd(m)), acc0);
+            acc1 = _mm256_fmadd_pd(h, _mm256_add_pd(_mm256_loadu_pd(x + 4), _mm256_loadu_pd(m + 4)), acc1);
+            acc2 = _mm256_fmadd_pd(h, _mm256_add_pd(_mm256_loadu_pd(x + 8), _mm256_loadu_pd(m + 8)), acc2);
+            acc3 = _mm256_fmadd_pd(h, _mm256_add_pd(_mm256_loadu_pd(x + 12), _mm256_loadu_pd(m + 12)), acc3);
+        }
+        if (kernel_length & 1) {
+            const double *x = input + i - half;
+            __m256d h = _mm256_broadcast_sd(coefficients + half);
+            acc0 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x), acc0);
+            acc1 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 4), acc1);
+            acc2 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 8), acc2);
+            acc3 = _mm256_fmadd_pd(h, _mm256_loadu_pd(x + 12), acc3);
+        }
+        _mm256_storeu_pd(output + i, acc0);
+        _mm256_storeu_pd(output + i + 4, acc1);
+        _mm256_storeu_pd(output + i + 8, acc2);
+        _mm256_storeu_pd(output + i + 12, acc3);
+    }
+    folded_kernel_tail_fma(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void direct_kernel_avx512(const double *coefficients, int kernel_length, const double *input, double *output,
+                                 int begin, int end) {
+    int i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+        for (int j = 0; j < kernel_length; ++j) {
+            const double *x = input + i - j;
+            __m512d h = _mm512_set1_pd(coefficients[j]);
+            acc0 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x), acc0);
+            acc1 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 8), acc1);
+            acc2 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 16), acc2);
+            acc3 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 24), acc3);
+        }
+        _mm512_storeu_pd(output + i, acc0);
+        _mm512_storeu_pd(output + i + 8, acc1);
+        _mm512_storeu_pd(output + i + 16, acc2);
+        _mm512_storeu_pd(output + i + 24, acc3);
+    }
+    direct_kernel_avx2(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void folded_kernel_avx512(const double *coefficients, int kernel_length, const double *input, double *output,
+                                 int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+        for (int j = 0; j < half; ++j) {
+            const double *x = input + i - j;
+            const double *m = input + i - last + j;
+            __m512d h = _mm512_set1_pd(coefficients[j]);
+            acc0 = _mm512_fmadd_pd(h, _mm512_add_pd(_mm512_loadu_pd(x), _mm512_loadu_pd(m)), acc0);
+            acc1 = _mm512_fmadd_pd(h, _mm512_add_pd(_mm512_loadu_pd(x + 8), _mm512_loadu_pd(m + 8)), acc1);
+            acc2 = _mm512_fmadd_pd(h, _mm512_add_pd(_mm512_loadu_pd(x + 16), _mm512_loadu_pd(m + 16)), acc2);
+            acc3 = _mm512_fmadd_pd(h, _mm512_add_pd(_mm512_loadu_pd(x + 24), _mm512_loadu_pd(m + 24)), acc3);
+        }
+        if (kernel_length & 1) {
+            const double *x = input + i - half;
+            __m512d h = _mm512_set1_pd(coefficients[half]);
+            acc0 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x), acc0);
+            acc1 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 8), acc1);
+            acc2 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 16), acc2);
+            acc3 = _mm512_fmadd_pd(h, _mm512_loadu_pd(x + 24), acc3);
+        }
+        _mm512_storeu_pd(output + i, acc0);
+        _mm512_storeu_pd(output + i + 8, acc1);
+        _mm512_storeu_pd(output + i + 16, acc2);
+        _mm512_storeu_pd(output + i + 24, acc3);
+    }
+    folded_kernel_avx2(coefficients, kernel_length, input, output, i, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the kernel of the given level, limited to the level supported by the running CPU
+static DoubleKernel select_double_kernel(FIRSimdLevel level, int is_symmetric) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return is_symmetric ? folded_kernel_avx512 : direct_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return is_symmetric ? folded_kernel_avx2 : direct_kernel_avx2;
+        default:
+            break;
+    }
+#endif
+    return is_symmetric ? folded_kernel_scalar : direct_kernel_scalar;
+}
+
+void apply_fir_filter_double_level(
+        FIRSimdLevel level,
+        const FIRFilterDouble *filter,
+        const double *input_signal,
+        double *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_double: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // The first kernel_length-1 outputs only overlap a part of the kernel, they are calculated directly
+    int kernel_length = filter->kernel_length;
+    for (int i = 0; i < MIN(kernel_length - 1, signal_length); ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < i + 1; ++j) {
+            sum += filter->coefficients[j] * input_signal[i - j];
+        }
+        output_signal[i] = sum;
+    }
+
+    if (signal_length > kernel_length - 1) {
+        DoubleKernel kernel = select_double_kernel(level, filter->is_symmetric);
+        kernel(filter->coefficients, kernel_length, input_signal, output_signal, kernel_length - 1, signal_length);
+    }
+}
+
+// API endpoint for applying the double-precision filter with the best kernel for the running CPU
+void apply_fir_filter_double(
+        const FIRFilterDouble *filter,
+        const double *input_signal,
+        double *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_double_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
+
+// API endpoint to free the memory held by the double-precision filter
+void destroy_fir_filter_double(FIRFilterDouble *filter) {
+    if (filter != NULL) {
+        free(filter->coefficients);
+        free(filter);
+    }
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fir_filter_fft.h"
+#include "fir_filter_internal.h"
+#include "fft.h"
+
+struct FIRFFTPlan {
+    FFTPlan *fft;               // Transform of fft_size samples
+    int kernel_length;          // Length of the filter kernel
+    int fft_size;               // Transform size
+    int block_length;           // New output samples per transform (fft_size - kernel_length + 1)
+    float *kernel_spectrum;     // Spectrum of the zero-padded kernel
+    float *block_spectrum;      // Work buffer for the spectrum of the current block
+    float *product_spectrum;    // Work buffer for the filtered spectrum
+    float *block;               // Work buffer for the current block in the time domain
+};
+
+// Choose the transform size for a convolution of the kernel with blocks of the signal.
+// Twice the kernel length keeps the ratio of useful samples per transform above one half,
+// while a short signal only needs a transform that holds its full (linear) convolution.
+static int overlap_add_fft_size(int kernel_length, int signal_length) {
+    int size = fft_next_size(2 * kernel_length);
+    return MIN(size, fft_next_size(signal_length + kernel_length - 1));
+}
+
+// API endpoint for applying the filter with the overlap-add method
+void apply_fir_filter_fft(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_fft: Invalid input parameter(s).\n");
+        return;
+    }
+    if (signal_length == 0) {
+        return;
+    }
+
+    // The signal is cut into blocks of block_length samples. Each block is zero-padded to the
+    // transform size, so that its linear convolution with the kernel fits in a single transform,
+    // and the convolutions of the consecutive blocks are added together (overlap-add).
+    int kernel_length = filter->kernel_length;
+    int fft_size = overlap_add_fft_size(kernel_length, signal_length);
+    int block_length = fft_size - kernel_length + 1;
+
+    FFTPlan *plan = create_fft_plan(fft_size);
+    float *kernel_spectrum = (float *) malloc((fft_size + 2) * sizeof(float));
+    float *block_spectrum = (float *) malloc((fft_size + 2) * sizeof(float));
+    float *product_spectrum = (float *) malloc((fft_size + 2) * sizeof(float));
+    float *block = (float *) malloc(fft_size * sizeof(float));
+    if (plan == NULL || kernel_spectrum == NULL || block_spectrum == NULL || product_spectrum == NULL ||
+        block == NULL) {
+        fprintf(stderr, "apply_fir_filter_fft: Memory allocation for the FFT convolution failed.\n");
+        goto cleanup;
+    }
+
+    // Transform the zero-padded kernel once
+    memcpy(block, filter->coefficients, kernel_length * sizeof(float));
+    memset(block + kernel_length, 0, (fft_size - kernel_length) * sizeof(float));
+    fft_forward(plan, block, kernel_spectrum);
+
+    memset(output_signal, 0, signal_length * sizeof(float));
+    for (int start = 0; start < signal_length; start += block_length) {
+        int input_count = MIN(block_length, signal_length - start);
+        memcpy(block, input_signal + start, input_count * sizeof(float));
+        memset(block + input_count, 0, (fft_size - input_count) * sizeof(float));
+
+        fft_forward(plan, block, block_spectrum);
+        memset(product_spectrum, 0, (fft_size + 2) * sizeof(float));
+        fft_multiply_accumulate(block_spectrum, kernel_spectrum, product_spectrum, fft_size / 2 + 1);
+        fft_inverse(plan, product_spectrum, block);
+
+        // The tail of the convolution beyond the signal length is truncated, as in apply_fir_filter
+        int output_count = MIN(fft_size, signal_length - start);
+        for (int i = 0; i < output_count; ++i) {
+            output_signal[start + i] += block[i];
+        }
+    }
+
+cleanup:
+    destroy_fft_plan(plan);
+    free(kernel_spectrum);
+    free(block_spectrum);
+    free(product_spectrum);
+    free(block);
+}
+
+// API endpoint to create an overlap-save plan
+FIRFFTPlan *create_fir_fft_plan(const FIRFilter *filter, int block_length) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 || block_length < 0) {
+        fprintf(stderr, "create_fir_fft_plan: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFFTPlan *plan = (FIRFFTPlan *) calloc(1, sizeof(FIRFFTPlan));
+    if (plan == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFFTPlan\n");
+        return NULL;
+    }
+
+    // Every transform has to hold kernel_length - 1 samples of history on top of the new samples
+    int kernel_length = filter->kernel_length;
+    if (block_length == 0) {
+        block_length = MAX(kernel_length, 64);
+    }
+    plan->kernel_length = kernel_length;
+    plan->fft_size = fft_next_size(block_length + kernel_length - 1);
+    plan->block_length = plan->fft_size - kernel_length + 1;
+
+    plan->fft = create_fft_plan(plan->fft_size);
+    plan->kernel_spectrum = (float *) malloc((plan->fft_size + 2) * sizeof(float));
+    plan->block_spectrum = (float *) malloc((plan->fft_size + 2) * sizeof(float));
+    plan->product_spectrum = (float *) malloc((plan->fft_size + 2) * sizeof(float));
+    plan->block = (float *) malloc(plan->fft_size * sizeof(float));
+    if (plan->fft == NULL || plan->kernel_spectrum == NULL || plan->block_spectrum == NULL ||
+        plan->product_spectrum == NULL || plan->block == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRFFTPlan buffers\n");
+        destroy_fir_fft_plan(plan);
+        return NULL;
+    }
+
+    // Transform the zero-padded kernel once, it is reused by every block of every signal
+    memcpy(plan->block, filter->coefficients, kernel_length * sizeof(float));
+    memset(plan->block + kernel_length, 0, (plan->fft_size - kernel_length) * sizeof(float));
+    fft_forward(plan->fft, plan->block, plan->kernel_spectrum);
+
+    return plan;
+}
+
+int fir_fft_plan_block_length(const FIRFFTPlan *plan) {
+    return plan != NULL ? plan->block_length : 0;
+}
+
+// API endpoint for applying the filter with the overlap-save method
+void apply_fir_fft_plan(
+        FIRFFTPlan *plan,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (plan == NULL || input_signal == NULL || output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_fft_plan: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // Each transform covers kernel_length - 1 samples of history followed by block_length new samples.
+    // The first kernel_length - 1 samples of the circular convolution are wrapped around (aliased)
+    // and are discarded, the remaining block_length samples are the linear convolution (overlap-save).
+    int history_length = plan->kernel_length - 1;
+    for (int start = 0; start < signal_length; start += plan->block_length) {
+        // Gather the input window [start - history_length, start + block_length), with zeros before the signal
+        for (int i = 0; i < plan->fft_size; ++i) {
+            int n = start - history_length + i;
+            plan->block[i] = (n >= 0 && n < signal_length) ? input_signal[n] : 0.0f;
+        }
+
+        fft_forward(plan->fft, plan->block, plan->block_spectrum);
+        memset(plan->product_spectrum, 0, (plan->fft_size + 2) * sizeof(float));
+        fft_multiply_accumulate(plan->block_spectrum, plan->kernel_spectrum, plan->product_spectrum,
+                                plan->fft_size / 2 + 1);
+        fft_inverse(plan->fft, plan->product_spectrum, plan->block);
+
+        int output_count = MIN(plan->block_length, signal_length - start);
+        memcpy(output_signal + start, plan->block + history_length, output_count * sizeof(float));
+    }
+}
+
+// API endpoint to free the memory held by the plan
+void destroy_fir_fft_plan(FIRFFTPlan *plan) {
+    if (plan != NULL) {
+        destroy_fft_plan(plan->fft);
+        free(plan->kernel_spectrum);
+        free(plan->block_spectrum);
+        free(plan->product_spectrum);
+        free(plan->block);
+        free(plan);
+    }
+}
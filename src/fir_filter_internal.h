@@ -0,0 +1,60 @@
+#ifndef FIR_FILTER_INTERNAL_H
+#define FIR_FILTER_INTERNAL_H
+
+#include "fir_filter.h"
+#include "fir_filter_simd.h"
+#include "fir_parallel.h"
+
+// Internal building blocks shared by the engines, not part of the public API
+
+// The vectorized kernels are compiled with per-function target attributes on x86 with GCC or Clang
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FIR_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define FIR_SIMD_X86 0
+#endif
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+
+// Computes the outputs [begin, end) of apply_fir_filter for the whole input signal, with the same arithmetic.
+// The parameters are not validated.
+void apply_fir_filter_range(
+        const FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int begin,
+        int end
+);
+
+// Computes the outputs [begin, end) of apply_fir_filter_simd_level for the whole input signal.
+// The parameters are not validated. Every output is the same no matter how the output range is split,
+// so engines may compute a signal in blocks or in parallel and get the output of one call.
+void apply_fir_filter_simd_range(
+        FIRSimdLevel level,
+        const FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int begin,
+        int end
+);
+
+// Returns the given instruction set level, limited to the level supported by the running CPU.
+// The kernel selectors of the engines switch on it, so a level above the CPU falls back to the best one below.
+FIRSimdLevel fir_simd_clamp_level(FIRSimdLevel level);
+
+// Returns the beta parameter of the Kaiser windows with a fixed beta (KAISER_B6, KAISER_B8, KAISER_B10), zero otherwise
+float fir_kaiser_window_beta(WindowType window);
+
+
+// Returns a monotonic wall-clock time in seconds, for timing the candidates of a calibration
+double fir_monotonic_seconds(void);
+
+// Runs task(context, index) for every index in [0, task_count) on the threads of the pool and the calling thread,
+// and returns when all tasks have finished. A pool runs one batch at a time, concurrent calls wait for each other.
+void run_fir_thread_pool(FIRThreadPool *pool, int task_count, void (*task)(void *context, int index), void *context);
+
+
+#endif // FIR_FILTER_INTERNAL_H
@@ -0,0 +1,410 @@
+#include <stdio.h>
+#include <math.h>
+#include "fir_filter_simd.h"
+#include "fir_filter_internal.h"
+
+// Every kernel computes the outputs [begin, end), for which the full kernel overlaps the signal (begin >= kernel_length - 1).
+// The outputs are computed in blocks of several vectors at once: each coefficient is broadcast once
+// and multiplied with one input vector per accumulator, so the accumulators stay in registers for the whole kernel.
+typedef void (*DirectKernel)(const float *coefficients, int kernel_length, const float *input, float *output,
+                             int begin, int end);
+
+// Portable scalar kernel, with the same summation order as apply_fir_filter
+static void direct_kernel_scalar(const float *coefficients, int kernel_length, const float *input, float *output,
+                                 int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float sum = 0.0f;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum += coefficients[j] * input[i - j];
+        }
+        output[i] = sum;
+    }
+}
+
+// Folded kernels for symmetric filters, with the same block structure as the direct kernels
+typedef void (*FoldedKernel)(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                             float *output, int begin, int end);
+
+// Symmetric kernels (h[j] == h[kernel_length-1-j]) are folded: the two input samples which meet the same
+// coefficient are added first, which halves the multiplications. The center tap of an odd kernel is added last.
+// With a tap step of 2 only every other tap pair, counted from the center, is visited, which skips the
+// structural zeros of half-band filters.
+static void folded_kernel_scalar(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                 float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    for (int i = begin; i < end; ++i) {
+        float sum = 0.0f;
+        for (int j = first; j < half; j += tap_step) {
+            sum += coefficients[j] * (input[i - j] + input[i - last + j]);
+        }
+        if (kernel_length & 1) {
+            sum += coefficients[half] * input[i - half];
+        }
+        output[i] = sum;
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void direct_kernel_sse41(const float *coefficients, int kernel_length, const float *input, float *output,
+                                int begin, int end) {
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + i - j;
+            __m128 h = _mm_set1_ps(coefficients[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+        }
+        _mm_storeu_ps(output + i, acc0);
+        _mm_storeu_ps(output + i + 4, acc1);
+        _mm_storeu_ps(output + i + 8, acc2);
+        _mm_storeu_ps(output + i + 12, acc3);
+    }
+    for (; i + 4 <= end; i += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(coefficients[j]), _mm_loadu_ps(input + i - j)));
+        }
+        _mm_storeu_ps(output + i, acc);
+    }
+    direct_kernel_scalar(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("sse4.1")))
+static void folded_kernel_sse41(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + i - j;
+            const float *m = input + i - last + j;
+            __m128 h = _mm_set1_ps(coefficients[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x), _mm_loadu_ps(m))));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 4), _mm_loadu_ps(m + 4))));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 8), _mm_loadu_ps(m + 8))));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_add_ps(_mm_loadu_ps(x + 12), _mm_loadu_ps(m + 12))));
+        }
+        if (kernel_length & 1) {
+            const float *x = input + i - half;
+            __m128 h = _mm_set1_ps(coefficients[half]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+        }
+        _mm_storeu_ps(output + i, acc0);
+        _mm_storeu_ps(output + i + 4, acc1);
+        _mm_storeu_ps(output + i + 8, acc2);
+        _mm_storeu_ps(output + i + 12, acc3);
+    }
+    folded_kernel_scalar(coefficients, kernel_length, tap_step, input, output, i, end);
+}
+
+// The remaining outputs of the FMA kernels are computed with fmaf, which rounds exactly like the vector lanes,
+// so every output is the same no matter which block it falls into
+__attribute__((target("avx2,fma")))
+static void direct_kernel_tail_fma(const float *coefficients, int kernel_length, const float *input, float *output,
+                                   int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float sum = 0.0f;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum = fmaf(coefficients[j], input[i - j], sum);
+        }
+        output[i] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_tail_fma(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                   float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    for (int i = begin; i < end; ++i) {
+        float sum = 0.0f;
+        for (int j = first; j < half; j += tap_step) {
+            sum = fmaf(coefficients[j], input[i - j] + input[i - last + j], sum);
+        }
+        if (kernel_length & 1) {
+            sum = fmaf(coefficients[half], input[i - half], sum);
+        }
+        output[i] = sum;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void direct_kernel_avx2(const float *coefficients, int kernel_length, const float *input, float *output,
+                               int begin, int end) {
+    int i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + i - j;
+            __m256 h = _mm256_broadcast_ss(coefficients + j);
+            acc0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 8), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 16), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 24), acc3);
+        }
+        _mm256_storeu_ps(output + i, acc0);
+        _mm256_storeu_ps(output + i + 8, acc1);
+        _mm256_storeu_ps(output + i + 16, acc2);
+        _mm256_storeu_ps(output + i + 24, acc3);
+    }
+    for (; i + 8 <= end; i += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm256_fmadd_ps(_mm256_broadcast_ss(coefficients + j), _mm256_loadu_ps(input + i - j), acc);
+        }
+        _mm256_storeu_ps(output + i, acc);
+    }
+    direct_kernel_tail_fma(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx2,fma")))
+static void folded_kernel_avx2(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                               float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + i - j;
+            const float *m = input + i - last + j;
+            __m256 h = _mm256_broadcast_ss(coefficients + j);
+            acc0 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x), _mm256_loadu_ps(m)), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 8), _mm256_loadu_ps(m + 8)), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 16), _mm256_loadu_ps(m + 16)), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_add_ps(_mm256_loadu_ps(x + 24), _mm256_loadu_ps(m + 24)), acc3);
+        }
+        if (kernel_length & 1) {
+            const float *x = input + i - half;
+            __m256 h = _mm256_broadcast_ss(coefficients + half);
+            acc0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x), acc0);
+            acc1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 8), acc1);
+            acc2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 16), acc2);
+            acc3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 24), acc3);
+        }
+        _mm256_storeu_ps(output + i, acc0);
+        _mm256_storeu_ps(output + i + 8, acc1);
+        _mm256_storeu_ps(output + i + 16, acc2);
+        _mm256_storeu_ps(output + i + 24, acc3);
+    }
+    folded_kernel_tail_fma(coefficients, kernel_length, tap_step, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void direct_kernel_avx512(const float *coefficients, int kernel_length, const float *input, float *output,
+                                 int begin, int end) {
+    int i = begin;
+    for (; i + 64 <= end; i += 64) {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            const float *x = input + i - j;
+            __m512 h = _mm512_set1_ps(coefficients[j]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 16), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 32), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 48), acc3);
+        }
+        _mm512_storeu_ps(output + i, acc0);
+        _mm512_storeu_ps(output + i + 16, acc1);
+        _mm512_storeu_ps(output + i + 32, acc2);
+        _mm512_storeu_ps(output + i + 48, acc3);
+    }
+    for (; i + 16 <= end; i += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (int j = 0; j < kernel_length; ++j) {
+            acc = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[j]), _mm512_loadu_ps(input + i - j), acc);
+        }
+        _mm512_storeu_ps(output + i, acc);
+    }
+    direct_kernel_tail_fma(coefficients, kernel_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void folded_kernel_avx512(const float *coefficients, int kernel_length, int tap_step, const float *input,
+                                 float *output, int begin, int end) {
+    int half = kernel_length / 2;
+    int last = kernel_length - 1;
+    int first = half > 0 ? (half - 1) % tap_step : 0;
+    int i = begin;
+    for (; i + 64 <= end; i += 64) {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+        for (int j = first; j < half; j += tap_step) {
+            const float *x = input + i - j;
+            const float *m = input + i - last + j;
+            __m512 h = _mm512_set1_ps(coefficients[j]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x), _mm512_loadu_ps(m)), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 16), _mm512_loadu_ps(m + 16)), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 32), _mm512_loadu_ps(m + 32)), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_add_ps(_mm512_loadu_ps(x + 48), _mm512_loadu_ps(m + 48)), acc3);
+        }
+        if (kernel_length & 1) {
+            const float *x = input + i - half;
+            __m512 h = _mm512_set1_ps(coefficients[half]);
+            acc0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x), acc0);
+            acc1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 16), acc1);
+            acc2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 32), acc2);
+            acc3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 48), acc3);
+        }
+        _mm512_storeu_ps(output + i, acc0);
+        _mm512_storeu_ps(output + i + 16, acc1);
+        _mm512_storeu_ps(output + i + 32, acc2);
+        _mm512_storeu_ps(output + i + 48, acc3);
+    }
+    folded_kernel_tail_fma(coefficients, kernel_length, tap_step, input, output, i, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// API endpoint to detect the instruction set level of the running CPU
+FIRSimdLevel fir_simd_detect(void) {
+    static int detected = -1;
+    if (detected < 0) {
+        FIRSimdLevel level = FIR_SIMD_SCALAR;
+#if FIR_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.1")) level = FIR_SIMD_SSE41;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) level = FIR_SIMD_AVX2;
+        if (level == FIR_SIMD_AVX2 && __builtin_cpu_supports("avx512f")) level = FIR_SIMD_AVX512;
+#endif
+        detected = (int) level;
+    }
+    return (FIRSimdLevel) detected;
+}
+
+FIRSimdLevel fir_simd_clamp_level(FIRSimdLevel level) {
+    FIRSimdLevel supported = fir_simd_detect();
+    return level > supported ? supported : level;
+}
+
+const char *fir_simd_level_name(FIRSimdLevel level) {
+    switch (level) {
+        case FIR_SIMD_SCALAR:
+            return "scalar";
+        case FIR_SIMD_SSE41:
+            return "sse4.1";
+        case FIR_SIMD_AVX2:
+            return "avx2";
+        case FIR_SIMD_AVX512:
+            return "avx512";
+        default:
+            return "unknown";
+    }
+}
+
+// Select the kernel of the given level, limited to the level supported by the running CPU
+static DirectKernel select_direct_kernel(FIRSimdLevel level) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return direct_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return direct_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return direct_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return direct_kernel_scalar;
+}
+
+// Select the folded kernel of the given level, limited to the level supported by the running CPU
+static FoldedKernel select_folded_kernel(FIRSimdLevel level) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            return folded_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return folded_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return folded_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return folded_kernel_scalar;
+}
+
+// API endpoint for applying the filter with the kernel of a given level
+void apply_fir_filter_simd_range(
+        FIRSimdLevel level,
+        const FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int begin,
+        int end
+) {
+    // The first kernel_length-1 outputs only overlap a part of the kernel, they are calculated as in apply_fir_filter
+    int kernel_length = filter->kernel_length;
+    for (int i = begin; i < MIN(kernel_length - 1, end); ++i) {
+        float sum = 0.0f;
+        for (int j = 0; j < i + 1; ++j) {
+            sum += filter->coefficients[j] * input_signal[i - j];
+        }
+        output_signal[i] = sum;
+    }
+
+    // The rest of the output is calculated by the vectorized kernel, folded for symmetric filters
+    // and restricted to the non-zero taps for half-band filters
+    begin = MAX(begin, kernel_length - 1);
+    if (begin >= end) {
+        return;
+    }
+    if (filter->is_half_band || filter->is_symmetric) {
+        FoldedKernel kernel = select_folded_kernel(level);
+        kernel(filter->coefficients, kernel_length, filter->is_half_band ? 2 : 1, input_signal, output_signal,
+               begin, end);
+    } else {
+        DirectKernel kernel = select_direct_kernel(level);
+        kernel(filter->coefficients, kernel_length, input_signal, output_signal, begin, end);
+    }
+}
+
+void apply_fir_filter_simd_level(
+        FIRSimdLevel level,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_simd: Invalid input parameter(s).\n");
+        return;
+    }
+
+    apply_fir_filter_simd_range(level, filter, input_signal, output_signal, 0, signal_length);
+}
+
+// API endpoint for applying the filter with the best kernel for the running CPU
+void apply_fir_filter_simd(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_simd_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
@@ -0,0 +1,330 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fir_fixed_point.h"
+#include "fir_filter_internal.h"
+
+// The vectorized kernels read the reversed kernel in steps of 8, 16 or 32 taps. It is zero-padded in front to a
+// multiple of the widest step, and every kernel uses the end of it padded to a multiple of its own step.
+#define Q15_TAP_BLOCK 32
+
+// Largest absolute coefficient sum for which a 32-bit accumulator cannot overflow with full-scale input,
+// as every partial sum is bounded by absolute_sum * 32768 < 2^31
+#define Q15_ACCUMULATOR_32_LIMIT 65536
+
+// Coefficients are quantized to the symmetric range, so that the sum of a pmaddwd pair always fits in 32 bits
+#define Q15_COEFFICIENT_MAX 32767
+
+// Round a Q30 sum to the nearest integer of the Q15 output and saturate it to the int16 range
+static int16_t round_q30_to_int16(int64_t sum) {
+    int64_t value = (sum + (1 << 14)) >> 15;
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t) value;
+}
+
+FIRFilterQ15 *quantize_fir_filter_q15(const FIRFilter *filter) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0) {
+        fprintf(stderr, "quantize_fir_filter_q15: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFilterQ15 *quantized = (FIRFilterQ15 *) malloc(sizeof(FIRFilterQ15));
+    if (quantized == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilterQ15\n");
+        return NULL;
+    }
+    quantized->kernel_length = filter->kernel_length;
+    quantized->coefficients = (int16_t *) malloc(filter->kernel_length * sizeof(int16_t));
+    if (quantized->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the Q15 filter\n");
+        free(quantized);
+        return NULL;
+    }
+
+    quantized->padded_length = (filter->kernel_length + Q15_TAP_BLOCK - 1) / Q15_TAP_BLOCK * Q15_TAP_BLOCK;
+    quantized->reversed_coefficients = (int16_t *) calloc(quantized->padded_length, sizeof(int16_t));
+    if (quantized->reversed_coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the reversed Q15 kernel\n");
+        free(quantized->coefficients);
+        free(quantized);
+        return NULL;
+    }
+
+    quantized->absolute_sum = 0;
+    for (int j = 0; j < filter->kernel_length; ++j) {
+        double value = floor((double) filter->coefficients[j] * 32768.0 + 0.5);
+        if (value > Q15_COEFFICIENT_MAX) value = Q15_COEFFICIENT_MAX;
+        if (value < -Q15_COEFFICIENT_MAX) value = -Q15_COEFFICIENT_MAX;
+        quantized->coefficients[j] = (int16_t) value;
+        quantized->reversed_coefficients[quantized->padded_length - 1 - j] = (int16_t) value;
+        quantized->absolute_sum += quantized->coefficients[j] < 0 ? -quantized->coefficients[j]
+                                                                  : quantized->coefficients[j];
+    }
+    return quantized;
+}
+
+// Every kernel computes the outputs [begin, end) from the reversed, zero-padded kernel of padded_length taps,
+// for which the whole padded kernel overlaps the signal (begin >= padded_length - 1).
+// Output i is the dot product of the reversed kernel and the input samples from i - padded_length + 1 on.
+typedef void (*Q15Kernel)(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                          int begin, int end);
+
+// Portable scalar kernel with a 64-bit accumulator
+static void q15_kernel_scalar(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                              int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        const int16_t *x = input + i - padded_length + 1;
+        int64_t sum = 0;
+        for (int k = 0; k < padded_length; ++k) {
+            sum += (int32_t) reversed[k] * x[k];
+        }
+        output[i] = round_q30_to_int16(sum);
+    }
+}
+
+#if FIR_SIMD_X86
+
+// pmaddwd multiplies 8 pairs of int16 and adds each pair into an int32 lane, 4 outputs share every coefficient load
+__attribute__((target("sse4.1")))
+static void q15_kernel_sse41(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                             int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+        __m128i acc2 = _mm_setzero_si128(), acc3 = _mm_setzero_si128();
+        for (int k = 0; k < padded_length; k += 8) {
+            __m128i h = _mm_loadu_si128((const __m128i *) (reversed + k));
+            const int16_t *x = base + i + k;
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(h, _mm_loadu_si128((const __m128i *) x)));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(h, _mm_loadu_si128((const __m128i *) (x + 1))));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(h, _mm_loadu_si128((const __m128i *) (x + 2))));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(h, _mm_loadu_si128((const __m128i *) (x + 3))));
+        }
+        // Two horizontal additions reduce the four accumulators to one sum per output
+        __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(acc0, acc1), _mm_hadd_epi32(acc2, acc3));
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i *) lanes, sums);
+        for (int lane = 0; lane < 4; ++lane) {
+            output[i + lane] = round_q30_to_int16(lanes[lane]);
+        }
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+__attribute__((target("avx2")))
+static void q15_kernel_avx2(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                            int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256(), acc3 = _mm256_setzero_si256();
+        for (int k = 0; k < padded_length; k += 16) {
+            __m256i h = _mm256_loadu_si256((const __m256i *) (reversed + k));
+            const int16_t *x = base + i + k;
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(h, _mm256_loadu_si256((const __m256i *) x)));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(h, _mm256_loadu_si256((const __m256i *) (x + 1))));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(h, _mm256_loadu_si256((const __m256i *) (x + 2))));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(h, _mm256_loadu_si256((const __m256i *) (x + 3))));
+        }
+        // Horizontal additions within the 128-bit lanes, then the two lanes are added
+        __m256i sums = _mm256_hadd_epi32(_mm256_hadd_epi32(acc0, acc1), _mm256_hadd_epi32(acc2, acc3));
+        __m128i total = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i *) lanes, total);
+        for (int lane = 0; lane < 4; ++lane) {
+            output[i + lane] = round_q30_to_int16(lanes[lane]);
+        }
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void q15_kernel_avx512(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                              int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+        __m512i acc2 = _mm512_setzero_si512(), acc3 = _mm512_setzero_si512();
+        for (int k = 0; k < padded_length; k += 32) {
+            __m512i h = _mm512_loadu_si512((const void *) (reversed + k));
+            const int16_t *x = base + i + k;
+            acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(h, _mm512_loadu_si512((const void *) x)));
+            acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(h, _mm512_loadu_si512((const void *) (x + 1))));
+            acc2 = _mm512_add_epi32(acc2, _mm512_madd_epi16(h, _mm512_loadu_si512((const void *) (x + 2))));
+            acc3 = _mm512_add_epi32(acc3, _mm512_madd_epi16(h, _mm512_loadu_si512((const void *) (x + 3))));
+        }
+        output[i] = round_q30_to_int16(_mm512_reduce_add_epi32(acc0));
+        output[i + 1] = round_q30_to_int16(_mm512_reduce_add_epi32(acc1));
+        output[i + 2] = round_q30_to_int16(_mm512_reduce_add_epi32(acc2));
+        output[i + 3] = round_q30_to_int16(_mm512_reduce_add_epi32(acc3));
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+// The wide kernels widen every pmaddwd result to 64-bit lanes, for filters whose coefficient sum allows
+// a 32-bit accumulator to overflow; a single pair sum is below 2^31 with the symmetric coefficient range
+__attribute__((target("sse4.1")))
+static void q15_kernel_sse41_wide(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                                  int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i acc[4];
+        for (int lane = 0; lane < 4; ++lane) acc[lane] = _mm_setzero_si128();
+        for (int k = 0; k < padded_length; k += 8) {
+            __m128i h = _mm_loadu_si128((const __m128i *) (reversed + k));
+            for (int lane = 0; lane < 4; ++lane) {
+                __m128i pairs = _mm_madd_epi16(h, _mm_loadu_si128((const __m128i *) (base + i + lane + k)));
+                acc[lane] = _mm_add_epi64(acc[lane], _mm_cvtepi32_epi64(pairs));
+                acc[lane] = _mm_add_epi64(acc[lane], _mm_cvtepi32_epi64(_mm_srli_si128(pairs, 8)));
+            }
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            int64_t sums[2];
+            _mm_storeu_si128((__m128i *) sums, acc[lane]);
+            output[i + lane] = round_q30_to_int16(sums[0] + sums[1]);
+        }
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+__attribute__((target("avx2")))
+static void q15_kernel_avx2_wide(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                                 int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256i acc[4];
+        for (int lane = 0; lane < 4; ++lane) acc[lane] = _mm256_setzero_si256();
+        for (int k = 0; k < padded_length; k += 16) {
+            __m256i h = _mm256_loadu_si256((const __m256i *) (reversed + k));
+            for (int lane = 0; lane < 4; ++lane) {
+                __m256i pairs = _mm256_madd_epi16(h, _mm256_loadu_si256((const __m256i *) (base + i + lane + k)));
+                acc[lane] = _mm256_add_epi64(acc[lane], _mm256_cvtepi32_epi64(_mm256_castsi256_si128(pairs)));
+                acc[lane] = _mm256_add_epi64(acc[lane], _mm256_cvtepi32_epi64(_mm256_extracti128_si256(pairs, 1)));
+            }
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            int64_t sums[4];
+            _mm256_storeu_si256((__m256i *) sums, acc[lane]);
+            output[i + lane] = round_q30_to_int16(sums[0] + sums[1] + sums[2] + sums[3]);
+        }
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void q15_kernel_avx512_wide(const int16_t *reversed, int padded_length, const int16_t *input, int16_t *output,
+                                   int begin, int end) {
+    const int16_t *base = input - padded_length + 1;
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m512i acc[4];
+        for (int lane = 0; lane < 4; ++lane) acc[lane] = _mm512_setzero_si512();
+        for (int k = 0; k < padded_length; k += 32) {
+            __m512i h = _mm512_loadu_si512((const void *) (reversed + k));
+            for (int lane = 0; lane < 4; ++lane) {
+                __m512i pairs = _mm512_madd_epi16(h, _mm512_loadu_si512((const void *) (base + i + lane + k)));
+                acc[lane] = _mm512_add_epi64(acc[lane], _mm512_cvtepi32_epi64(_mm512_castsi512_si256(pairs)));
+                acc[lane] = _mm512_add_epi64(acc[lane], _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(pairs, 1)));
+            }
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            output[i + lane] = round_q30_to_int16(_mm512_reduce_add_epi64(acc[lane]));
+        }
+    }
+    q15_kernel_scalar(reversed, padded_length, input, output, i, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the kernel of the given level, limited to the level supported by the running CPU,
+// with 64-bit accumulation when the coefficient sum allows a 32-bit accumulator to overflow.
+// The number of taps the kernel reads per step is stored in tap_block.
+static Q15Kernel select_q15_kernel(FIRSimdLevel level, int wide, int *tap_block) {
+    level = fir_simd_clamp_level(level);
+#if FIR_SIMD_X86
+    switch (level) {
+        case FIR_SIMD_AVX512:
+            if (__builtin_cpu_supports("avx512bw")) {
+                *tap_block = 32;
+                return wide ? q15_kernel_avx512_wide : q15_kernel_avx512;
+            }
+            *tap_block = 16;
+            return wide ? q15_kernel_avx2_wide : q15_kernel_avx2;
+        case FIR_SIMD_AVX2:
+            *tap_block = 16;
+            return wide ? q15_kernel_avx2_wide : q15_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            *tap_block = 8;
+            return wide ? q15_kernel_sse41_wide : q15_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    (void) wide;
+    *tap_block = 1;
+    return q15_kernel_scalar;
+}
+
+void apply_fir_filter_q15_level(
+        FIRSimdLevel level,
+        const FIRFilterQ15 *filter,
+        const int16_t *input_signal,
+        int16_t *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->reversed_coefficients == NULL ||
+        filter->kernel_length <= 0 || input_signal == NULL || output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_q15: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // The reversed kernel padded to a whole number of the tap blocks of the selected kernel
+    // is the end of the reversed kernel stored with the filter
+    int tap_block;
+    Q15Kernel kernel = select_q15_kernel(level, filter->absolute_sum >= Q15_ACCUMULATOR_32_LIMIT, &tap_block);
+    int kernel_length = filter->kernel_length;
+    int padded_length = (kernel_length + tap_block - 1) / tap_block * tap_block;
+    const int16_t *reversed = filter->reversed_coefficients + filter->padded_length - padded_length;
+
+    // The outputs which do not overlap the whole padded kernel are calculated with the taps over the signal only
+    for (int i = 0; i < MIN(padded_length - 1, signal_length); ++i) {
+        int64_t sum = 0;
+        for (int j = 0; j < MIN(i + 1, kernel_length); ++j) {
+            sum += (int32_t) filter->coefficients[j] * input_signal[i - j];
+        }
+        output_signal[i] = round_q30_to_int16(sum);
+    }
+
+    // All kernels accumulate exactly, so every level produces the same output
+    if (signal_length > padded_length - 1) {
+        kernel(reversed, padded_length, input_signal, output_signal, padded_length - 1, signal_length);
+    }
+}
+
+// API endpoint for applying the Q15 filter with the best kernel for the running CPU
+void apply_fir_filter_q15(
+        const FIRFilterQ15 *filter,
+        const int16_t *input_signal,
+        int16_t *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_q15_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
+
+// API endpoint to free the memory held by the Q15 filter
+void destroy_fir_filter_q15(FIRFilterQ15 *filter) {
+    if (filter != NULL) {
+        free(filter->coefficients);
+        free(filter->reversed_coefficients);
+        free(filter);
+    }
+}
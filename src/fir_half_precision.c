@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fir_half_precision.h"
+#include "fir_filter_internal.h"
+
+// Number of outputs widened, filtered and narrowed at a time, the float buffers stay in the L2 cache
+#define HALF_BLOCK_LENGTH 4096
+
+// Scalar conversions, bit-exact with the F16C and AVX-512 BF16 instructions
+
+static uint16_t float_to_fp16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    int exponent = (int) ((bits >> 23) & 0xFF);
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    // NaN is quieted with the upper payload bits kept, infinity stays infinity
+    if (exponent == 0xFF) {
+        return (uint16_t) (sign | 0x7C00 | (mantissa != 0 ? 0x200 | (mantissa >> 13) : 0));
+    }
+
+    int half_exponent = exponent - 127 + 15;
+    if (half_exponent >= 31) {
+        return (uint16_t) (sign | 0x7C00);
+    }
+
+    uint32_t half, remainder, halfway;
+    if (half_exponent <= 0) {
+        // Subnormal half, the implicit bit is shifted into the mantissa
+        if (half_exponent < -10) {
+            return (uint16_t) sign;
+        }
+        mantissa |= 0x800000;
+        int shift = 14 - half_exponent;
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    } else {
+        half = ((uint32_t) half_exponent << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1FFF;
+        halfway = 0x1000;
+    }
+
+    // Round to nearest even, a carry out of the mantissa correctly increments the exponent (up to infinity)
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+        ++half;
+    }
+    return (uint16_t) (sign | half);
+}
+
+static float fp16_to_float(uint16_t half) {
+    uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+    uint32_t bits;
+
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13) | (mantissa != 0 ? 0x400000 : 0);
+    } else if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Normalize the subnormal half
+            uint32_t float_exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                --float_exponent;
+            }
+            bits = sign | (float_exponent << 23) | ((mantissa & 0x3FF) << 13);
+        }
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint16_t float_to_bf16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+        return (uint16_t) ((bits >> 16) | 0x40);
+    }
+    if ((bits & 0x7F800000) == 0) {
+        return (uint16_t) ((bits >> 16) & 0x8000);
+    }
+    return (uint16_t) ((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+static float bf16_to_float(uint16_t half) {
+    uint32_t bits = (uint32_t) half << 16;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+typedef void (*NarrowKernel)(const float *input, uint16_t *output, int length);
+typedef void (*WidenKernel)(const uint16_t *input, float *output, int length);
+
+static void narrow_fp16_scalar(const float *input, uint16_t *output, int length) {
+    for (int i = 0; i < length; ++i) {
+        output[i] = float_to_fp16(input[i]);
+    }
+}
+
+static void widen_fp16_scalar(const uint16_t *input, float *output, int length) {
+    for (int i = 0; i < length; ++i) {
+        output[i] = fp16_to_float(input[i]);
+    }
+}
+
+static void narrow_bf16_scalar(const float *input, uint16_t *output, int length) {
+    for (int i = 0; i < length; ++i) {
+        output[i] = float_to_bf16(input[i]);
+    }
+}
+
+static void widen_bf16_scalar(const uint16_t *input, float *output, int length) {
+    for (int i = 0; i < length; ++i) {
+        output[i] = bf16_to_float(input[i]);
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("avx,f16c")))
+static void narrow_fp16_f16c(const float *input, uint16_t *output, int length) {
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128((__m128i *) (output + i), half);
+    }
+    narrow_fp16_scalar(input + i, output + i, length - i);
+}
+
+__attribute__((target("avx,f16c")))
+static void widen_fp16_f16c(const uint16_t *input, float *output, int length) {
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (input + i))));
+    }
+    widen_fp16_scalar(input + i, output + i, length - i);
+}
+
+// Rounding to nearest even with integer operations, for CPUs without the AVX-512 BF16 instruction
+__attribute__((target("avx2")))
+static void narrow_bf16_avx2(const float *input, uint16_t *output, int length) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i rounding = _mm256_set1_epi32(0x7FFF);
+    const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i exponent_mask = _mm256_set1_epi32(0x7F800000);
+    const __m256i sign_mask = _mm256_set1_epi32((int) 0x80000000u);
+    const __m256i quiet = _mm256_set1_epi32(0x40);
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(input + i));
+        __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(rounding, lsb)), 16);
+        __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+        __m256i zero = _mm256_srli_epi32(_mm256_and_si256(bits, sign_mask), 16);
+        __m256i is_nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, abs_mask), exponent_mask);
+        __m256i is_subnormal = _mm256_cmpeq_epi32(_mm256_and_si256(bits, exponent_mask), _mm256_setzero_si256());
+        __m256i result = _mm256_blendv_epi8(_mm256_blendv_epi8(rounded, zero, is_subnormal), nan, is_nan);
+        // Pack the 32-bit lanes to 16 bits and restore the order of the two 128-bit halves
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+        _mm_storeu_si128((__m128i *) (output + i), _mm256_castsi256_si128(packed));
+    }
+    narrow_bf16_scalar(input + i, output + i, length - i);
+}
+
+__attribute__((target("avx512f,avx512bf16,avx512vl")))
+static void narrow_bf16_avx512(const float *input, uint16_t *output, int length) {
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m256bh half = _mm512_cvtneps_pbh(_mm512_loadu_ps(input + i));
+        _mm256_storeu_si256((__m256i *) (output + i), (__m256i) half);
+    }
+    narrow_bf16_scalar(input + i, output + i, length - i);
+}
+
+__attribute__((target("avx2")))
+static void widen_bf16_avx2(const uint16_t *input, float *output, int length) {
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) (input + i)));
+        _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+    }
+    widen_bf16_scalar(input + i, output + i, length - i);
+}
+
+#endif // FIR_SIMD_X86
+
+// The conversions give the same bits with every kernel, so the best one for the running CPU is always used
+static NarrowKernel select_narrow_kernel(FIRHalfFormat format) {
+#if FIR_SIMD_X86
+    if (format == FIR_HALF_FP16 && __builtin_cpu_supports("f16c")) {
+        return narrow_fp16_f16c;
+    }
+    if (format == FIR_HALF_BF16 && __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512vl")) {
+        return narrow_bf16_avx512;
+    }
+    if (format == FIR_HALF_BF16 && __builtin_cpu_supports("avx2")) {
+        return narrow_bf16_avx2;
+    }
+#endif
+    return format == FIR_HALF_FP16 ? narrow_fp16_scalar : narrow_bf16_scalar;
+}
+
+static WidenKernel select_widen_kernel(FIRHalfFormat format) {
+#if FIR_SIMD_X86
+    if (format == FIR_HALF_FP16 && __builtin_cpu_supports("f16c")) {
+        return widen_fp16_f16c;
+    }
+    if (format == FIR_HALF_BF16 && __builtin_cpu_supports("avx2")) {
+        return widen_bf16_avx2;
+    }
+#endif
+    return format == FIR_HALF_FP16 ? widen_fp16_scalar : widen_bf16_scalar;
+}
+
+void fir_float_to_half(FIRHalfFormat format, const float *input, uint16_t *output, int length) {
+    // Validate the input parameters
+    if ((format != FIR_HALF_FP16 && format != FIR_HALF_BF16) || input == NULL || output == NULL || length < 0) {
+        fprintf(stderr, "fir_float_to_half: Invalid input parameter(s).\n");
+        return;
+    }
+    select_narrow_kernel(format)(input, output, length);
+}
+
+void fir_half_to_float(FIRHalfFormat format, const uint16_t *input, float *output, int length) {
+    // Validate the input parameters
+    if ((format != FIR_HALF_FP16 && format != FIR_HALF_BF16) || input == NULL || output == NULL || length < 0) {
+        fprintf(stderr, "fir_half_to_float: Invalid input parameter(s).\n");
+        return;
+    }
+    select_widen_kernel(format)(input, output, length);
+}
+
+FIRFilterHalf *convert_fir_filter_half(const FIRFilter *filter, FIRHalfFormat format) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 ||
+        (format != FIR_HALF_FP16 && format != FIR_HALF_BF16)) {
+        fprintf(stderr, "convert_fir_filter_half: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRFilterHalf *converted = (FIRFilterHalf *) malloc(sizeof(FIRFilterHalf));
+    if (converted == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilterHalf\n");
+        return NULL;
+    }
+    converted->format = format;
+    converted->kernel_length = filter->kernel_length;
+    converted->coefficients = (uint16_t *) malloc(filter->kernel_length * sizeof(uint16_t));
+    if (converted->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the 16-bit filter\n");
+        free(converted);
+        return NULL;
+    }
+
+    select_narrow_kernel(format)(filter->coefficients, converted->coefficients, filter->kernel_length);
+    return converted;
+}
+
+void apply_fir_filter_half_level(
+        FIRSimdLevel level,
+        const FIRFilterHalf *filter,
+        const uint16_t *input_signal,
+        uint16_t *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 || input_signal == NULL ||
+        output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_half: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // Widen the coefficients once, the widened filter is folded or reduced to its non-zero taps like any other
+    int kernel_length = filter->kernel_length;
+    FIRFilter widened = {0};
+    widened.kernel_length = kernel_length;
+    widened.coefficients = (float *) malloc(kernel_length * sizeof(float));
+    float *input_block = (float *) malloc((HALF_BLOCK_LENGTH + kernel_length - 1) * sizeof(float));
+    float *output_block = (float *) malloc((HALF_BLOCK_LENGTH + kernel_length - 1) * sizeof(float));
+    if (widened.coefficients == NULL || input_block == NULL || output_block == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the widened signal blocks\n");
+        free(widened.coefficients);
+        free(input_block);
+        free(output_block);
+        return;
+    }
+    WidenKernel widen = select_widen_kernel(filter->format);
+    NarrowKernel narrow = select_narrow_kernel(filter->format);
+    widen(filter->coefficients, widened.coefficients, kernel_length);
+    detect_fir_filter_structure(&widened);
+
+    // Every block widens its outputs and the kernel_length - 1 input samples before them. Past the start
+    // of the signal the whole kernel overlaps the block, so the block outputs equal those of one call.
+    for (int begin = 0; begin < signal_length; begin += HALF_BLOCK_LENGTH) {
+        int end = MIN(begin + HALF_BLOCK_LENGTH, signal_length);
+        int start = MAX(0, begin - (kernel_length - 1));
+        widen(input_signal + start, input_block, end - start);
+        apply_fir_filter_simd_range(level, &widened, input_block, output_block, begin - start, end - start);
+        narrow(output_block + (begin - start), output_signal + begin, end - begin);
+    }
+
+    free(widened.coefficients);
+    free(input_block);
+    free(output_block);
+}
+
+// API endpoint for applying the 16-bit filter with the best kernel for the running CPU
+void apply_fir_filter_half(
+        const FIRFilterHalf *filter,
+        const uint16_t *input_signal,
+        uint16_t *output_signal,
+        int signal_length
+) {
+    apply_fir_filter_half_level(fir_simd_detect(), filter, input_signal, output_signal, signal_length);
+}
+
+// API endpoint to free the memory held by the 16-bit filter
+void destroy_fir_filter_half(FIRFilterHalf *filter) {
+    if (filter != NULL) {
+        free(filter->coefficients);
+        free(filter);
+    }
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fir_min_phase.h"
+#include "fft.h"
+
+// Transform size relative to the kernel length. The cepstrum of a filter with stop band zeros decays slowly,
+// and a long transform keeps its aliasing below -85 dB of the peak of windowed-sinc designs.
+#define MIN_PHASE_OVERSAMPLING 64
+// Transform size above which very long filters are oversampled less (at least twice)
+#define MIN_PHASE_MAX_FFT_SIZE (1 << 24)
+// Smallest magnitude relative to the peak of the magnitude response (-200 dB) that enters the logarithm
+#define MIN_PHASE_MAGNITUDE_FLOOR 1e-10f
+
+// API endpoint to create the minimum-phase equivalent of a filter
+FIRFilter *convert_fir_filter_minimum_phase(const FIRFilter *filter, int kernel_length) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 || kernel_length < 0 ||
+        kernel_length > filter->kernel_length) {
+        fprintf(stderr, "convert_fir_filter_minimum_phase: Invalid input parameter(s).\n");
+        return NULL;
+    }
+    if (kernel_length == 0) {
+        kernel_length = filter->kernel_length;
+    }
+
+    long long oversampled_length = (long long) MIN_PHASE_OVERSAMPLING * filter->kernel_length;
+    if (oversampled_length > MIN_PHASE_MAX_FFT_SIZE) {
+        oversampled_length = MIN_PHASE_MAX_FFT_SIZE;
+    }
+    if (oversampled_length < 2LL * filter->kernel_length) {
+        oversampled_length = 2LL * filter->kernel_length;
+    }
+    int fft_size = fft_next_size((int) oversampled_length);
+    int bins = fft_size / 2 + 1;
+    FIRFilter *converted = NULL;
+    FFTPlan *plan = create_fft_plan(fft_size);
+    float *signal = (float *) malloc(fft_size * sizeof(float));
+    float *spectrum = (float *) malloc((fft_size + 2) * sizeof(float));
+    if (plan == NULL || signal == NULL || spectrum == NULL) {
+        fprintf(stderr, "convert_fir_filter_minimum_phase: Memory allocation for the cepstrum failed.\n");
+        goto cleanup;
+    }
+
+    // Log magnitude response of the zero-padded filter
+    memcpy(signal, filter->coefficients, filter->kernel_length * sizeof(float));
+    memset(signal + filter->kernel_length, 0, (fft_size - filter->kernel_length) * sizeof(float));
+    fft_forward(plan, signal, spectrum);
+    float peak = 0.0f;
+    for (int b = 0; b < bins; ++b) {
+        spectrum[2 * b] = hypotf(spectrum[2 * b], spectrum[2 * b + 1]);
+        spectrum[2 * b + 1] = 0.0f;
+        peak = fmaxf(peak, spectrum[2 * b]);
+    }
+    if (peak == 0.0f) {
+        fprintf(stderr, "convert_fir_filter_minimum_phase: The filter has no magnitude response.\n");
+        goto cleanup;
+    }
+    for (int b = 0; b < bins; ++b) {
+        spectrum[2 * b] = logf(fmaxf(spectrum[2 * b], peak * MIN_PHASE_MAGNITUDE_FLOOR));
+    }
+
+    // The real cepstrum is even. The cepstrum of the minimum-phase filter is causal: the negative quefrencies
+    // are folded onto the positive ones, c_min[n] = 2 c[n] for 0 < n < size / 2.
+    fft_inverse(plan, spectrum, signal);
+    for (int n = 1; n < fft_size / 2; ++n) {
+        signal[n] *= 2.0f;
+    }
+    for (int n = fft_size / 2 + 1; n < fft_size; ++n) {
+        signal[n] = 0.0f;
+    }
+
+    // H_min = exp(FFT(c_min)), with the real part as the log magnitude and the imaginary part as the phase
+    fft_forward(plan, signal, spectrum);
+    for (int b = 0; b < bins; ++b) {
+        float magnitude = expf(spectrum[2 * b]);
+        float phase = spectrum[2 * b + 1];
+        spectrum[2 * b] = magnitude * cosf(phase);
+        spectrum[2 * b + 1] = magnitude * sinf(phase);
+    }
+    fft_inverse(plan, spectrum, signal);
+
+    converted = (FIRFilter *) malloc(sizeof(FIRFilter));
+    if (converted == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilter\n");
+        goto cleanup;
+    }
+    *converted = *filter;
+    converted->kernel_length = kernel_length;
+    converted->coefficients = (float *) malloc(kernel_length * sizeof(float));
+    if (converted->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the filter\n");
+        free(converted);
+        converted = NULL;
+        goto cleanup;
+    }
+    // The energy of the minimum-phase filter is concentrated in its first taps, truncation keeps them
+    memcpy(converted->coefficients, signal, kernel_length * sizeof(float));
+    detect_fir_filter_structure(converted);
+
+cleanup:
+    destroy_fft_plan(plan);
+    free(signal);
+    free(spectrum);
+    return converted;
+}
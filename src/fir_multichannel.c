@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <math.h>
+#include "fir_multichannel.h"
+#include "fir_filter_internal.h"
+
+// Every interleaved kernel computes all channels of the frames [begin, end), for which the full kernel
+// overlaps the signal (begin >= kernel_length - 1). Within a frame, blocks of channels are accumulated
+// in registers: each coefficient is broadcast once and multiplied with one vector of channels per accumulator,
+// the input of tap j being the frame j frames back, channel_count samples apart.
+typedef void (*InterleavedKernel)(const float *coefficients, int kernel_length, const float *input, float *output,
+                                  int channel_count, int begin, int end);
+
+// Portable scalar kernel, with the same summation order as apply_fir_filter
+static void interleaved_kernel_scalar(const float *coefficients, int kernel_length, const float *input,
+                                      float *output, int channel_count, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        for (int c = 0; c < channel_count; ++c) {
+            const float *x = input + (long long) i * channel_count + c;
+            float sum = 0.0f;
+            for (int j = 0; j < kernel_length; ++j) {
+                sum += coefficients[j] * x[-(long long) j * channel_count];
+            }
+            output[(long long) i * channel_count + c] = sum;
+        }
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void interleaved_kernel_sse41(const float *coefficients, int kernel_length, const float *input,
+                                     float *output, int channel_count, int begin, int end) {
+    long long stride = channel_count;
+    for (int i = begin; i < end; ++i) {
+        const float *frame = input + i * stride;
+        float *out = output + i * stride;
+        int c = 0;
+        for (; c + 16 <= channel_count; c += 16) {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                const float *x = frame - j * stride + c;
+                __m128 h = _mm_set1_ps(coefficients[j]);
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+            }
+            _mm_storeu_ps(out + c, acc0);
+            _mm_storeu_ps(out + c + 4, acc1);
+            _mm_storeu_ps(out + c + 8, acc2);
+            _mm_storeu_ps(out + c + 12, acc3);
+        }
+        for (; c + 4 <= channel_count; c += 4) {
+            __m128 acc = _mm_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(coefficients[j]), _mm_loadu_ps(frame - j * stride + c)));
+            }
+            _mm_storeu_ps(out + c, acc);
+        }
+        for (; c < channel_count; ++c) {
+            float sum = 0.0f;
+            for (int j = 0; j < kernel_length; ++j) {
+                sum += coefficients[j] * frame[c - j * stride];
+            }
+            out[c] = sum;
+        }
+    }
+}
+
+// The remaining channels of the FMA kernels are computed with fmaf, which rounds exactly like the vector lanes,
+// so every channel is the same no matter which block it falls into
+__attribute__((target("avx2,fma")))
+static void interleaved_kernel_avx2(const float *coefficients, int kernel_length, const float *input,
+                                    float *output, int channel_count, int begin, int end) {
+    long long stride = channel_count;
+    for (int i = begin; i < end; ++i) {
+        const float *frame = input + i * stride;
+        float *out = output + i * stride;
+        int c = 0;
+        for (; c + 32 <= channel_count; c += 32) {
+            __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+            __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                const float *x = frame - j * stride + c;
+                __m256 h = _mm256_set1_ps(coefficients[j]);
+                acc0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x), acc0);
+                acc1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 8), acc1);
+                acc2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 16), acc2);
+                acc3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(x + 24), acc3);
+            }
+            _mm256_storeu_ps(out + c, acc0);
+            _mm256_storeu_ps(out + c + 8, acc1);
+            _mm256_storeu_ps(out + c + 16, acc2);
+            _mm256_storeu_ps(out + c + 24, acc3);
+        }
+        for (; c + 8 <= channel_count; c += 8) {
+            __m256 acc = _mm256_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                acc = _mm256_fmadd_ps(_mm256_set1_ps(coefficients[j]), _mm256_loadu_ps(frame - j * stride + c), acc);
+            }
+            _mm256_storeu_ps(out + c, acc);
+        }
+        for (; c < channel_count; ++c) {
+            float sum = 0.0f;
+            for (int j = 0; j < kernel_length; ++j) {
+                sum = fmaf(coefficients[j], frame[c - j * stride], sum);
+            }
+            out[c] = sum;
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void interleaved_kernel_avx512(const float *coefficients, int kernel_length, const float *input,
+                                      float *output, int channel_count, int begin, int end) {
+    long long stride = channel_count;
+    for (int i = begin; i < end; ++i) {
+        const float *frame = input + i * stride;
+        float *out = output + i * stride;
+        int c = 0;
+        for (; c + 64 <= channel_count; c += 64) {
+            __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+            __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                const float *x = frame - j * stride + c;
+                __m512 h = _mm512_set1_ps(coefficients[j]);
+                acc0 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x), acc0);
+                acc1 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 16), acc1);
+                acc2 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 32), acc2);
+                acc3 = _mm512_fmadd_ps(h, _mm512_loadu_ps(x + 48), acc3);
+            }
+            _mm512_storeu_ps(out + c, acc0);
+            _mm512_storeu_ps(out + c + 16, acc1);
+            _mm512_storeu_ps(out + c + 32, acc2);
+            _mm512_storeu_ps(out + c + 48, acc3);
+        }
+        for (; c + 16 <= channel_count; c += 16) {
+            __m512 acc = _mm512_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                acc = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[j]), _mm512_loadu_ps(frame - j * stride + c), acc);
+            }
+            _mm512_storeu_ps(out + c, acc);
+        }
+        // Fewer than 16 channels left: a masked vector keeps the lanes of the remaining channels
+        if (c < channel_count) {
+            __mmask16 mask = (__mmask16) ((1u << (channel_count - c)) - 1);
+            __m512 acc = _mm512_setzero_ps();
+            for (int j = 0; j < kernel_length; ++j) {
+                acc = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[j]),
+                                      _mm512_maskz_loadu_ps(mask, frame - j * stride + c), acc);
+            }
+            _mm512_mask_storeu_ps(out + c, mask, acc);
+        }
+    }
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the interleaved kernel for the best instruction set level of the running CPU
+static InterleavedKernel select_interleaved_kernel(void) {
+#if FIR_SIMD_X86
+    switch (fir_simd_detect()) {
+        case FIR_SIMD_AVX512:
+            return interleaved_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return interleaved_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return interleaved_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return interleaved_kernel_scalar;
+}
+
+// API endpoint for applying the filter to every channel of a multi-channel signal
+void apply_fir_filter_multichannel(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int frame_count,
+        int channel_count,
+        FIRChannelLayout layout
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        frame_count < 0 || channel_count <= 0 ||
+        (layout != FIR_LAYOUT_INTERLEAVED && layout != FIR_LAYOUT_PLANAR)) {
+        fprintf(stderr, "apply_fir_filter_multichannel: Invalid input parameter(s).\n");
+        return;
+    }
+
+    // Planar channels are contiguous signals of their own
+    if (layout == FIR_LAYOUT_PLANAR) {
+        for (int c = 0; c < channel_count; ++c) {
+            apply_fir_filter_simd(filter, input_signal + (long long) c * frame_count,
+                                  output_signal + (long long) c * frame_count, frame_count);
+        }
+        return;
+    }
+
+    // The first kernel_length-1 frames only overlap a part of the kernel, they are calculated as in apply_fir_filter
+    int kernel_length = filter->kernel_length;
+    long long stride = channel_count;
+    for (int i = 0; i < MIN(kernel_length - 1, frame_count); ++i) {
+        for (int c = 0; c < channel_count; ++c) {
+            float sum = 0.0f;
+            for (int j = 0; j < i + 1; ++j) {
+                sum += filter->coefficients[j] * input_signal[(i - j) * stride + c];
+            }
+            output_signal[i * stride + c] = sum;
+        }
+    }
+
+    // The rest of the frames are calculated by the kernel vectorized across the channels
+    if (frame_count > kernel_length - 1) {
+        InterleavedKernel kernel = select_interleaved_kernel();
+        kernel(filter->coefficients, kernel_length, input_signal, output_signal, channel_count, kernel_length - 1,
+               frame_count);
+    }
+}
@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fir_multirate.h"
+#include "fir_filter_internal.h"
+
+// Number of output samples calculated together. The outputs of a block stay in the cache
+// while every tap of every phase is added to them.
+#define MULTIRATE_BLOCK_LENGTH 512
+
+// Polyphase split of a kernel: phase p holds the taps h[p], h[p + factor], h[p + 2 * factor], ...
+typedef struct {
+    int phase_count;        // Number of phases (the decimation or interpolation factor)
+    int tap_phase_count;    // Number of phases with taps, min(phase_count, kernel_length)
+    int phase_length;       // Taps per phase, ceil(kernel_length / phase_count)
+    float *taps;            // Stored phases * phase_length taps, zero-padded at the end of the short phases
+} PolyphaseKernel;
+
+// Split the coefficients into phases, returns 0 on success. A factor above the kernel length leaves the phases
+// from kernel_length on without taps, they are only stored (as zeros) when all_phases is set, so that the memory
+// of the engines which skip them does not grow with the factor.
+static int split_polyphase(PolyphaseKernel *kernel, const float *coefficients, int kernel_length, int phase_count,
+                           int all_phases) {
+    kernel->phase_count = phase_count;
+    kernel->tap_phase_count = MIN(phase_count, kernel_length);
+    kernel->phase_length = (kernel_length - 1) / phase_count + 1;
+    int stored_phase_count = all_phases ? phase_count : kernel->tap_phase_count;
+    kernel->taps = (float *) calloc((size_t) stored_phase_count * kernel->phase_length, sizeof(float));
+    if (kernel->taps == NULL) {
+        return -1;
+    }
+    for (int j = 0; j < kernel_length; ++j) {
+        kernel->taps[(j % phase_count) * kernel->phase_length + j / phase_count] = coefficients[j];
+    }
+    return 0;
+}
+
+int fir_decimated_length(int signal_length, int factor) {
+    if (signal_length <= 0 || factor <= 0) {
+        return 0;
+    }
+    return (signal_length - 1) / factor + 1;
+}
+
+// API endpoint for filtering and downsampling in one pass
+int apply_fir_decimate(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int factor
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0 || factor <= 0) {
+        fprintf(stderr, "apply_fir_decimate: Invalid input parameter(s).\n");
+        return -1;
+    }
+    int output_length = fir_decimated_length(signal_length, factor);
+    if (output_length == 0) {
+        return 0;
+    }
+
+    // The kept output y[k] = sum_j h[j] * x[k * factor - j] is split by the phase p = j % factor of the taps:
+    // y[k] = sum_p sum_m h[m * factor + p] * x_p[k - m], with the input components x_p[n] = x[n * factor - p].
+    // Both the phases and the components are contiguous, so the outputs of a block are updated with unit stride.
+    // Only the phases with taps and their components are built, the others add nothing to the output.
+    PolyphaseKernel kernel;
+    if (split_polyphase(&kernel, filter->coefficients, filter->kernel_length, factor, 0) != 0) {
+        fprintf(stderr, "apply_fir_decimate: Memory allocation for the polyphase kernel failed.\n");
+        return -1;
+    }
+    float *components = (float *) malloc((size_t) kernel.tap_phase_count * output_length * sizeof(float));
+    if (components == NULL) {
+        fprintf(stderr, "apply_fir_decimate: Memory allocation for the input components failed.\n");
+        free(kernel.taps);
+        return -1;
+    }
+    for (int p = 0; p < kernel.tap_phase_count; ++p) {
+        float *component = components + (size_t) p * output_length;
+        for (int n = 0; n < output_length; ++n) {
+            int index = n * factor - p;
+            component[n] = index >= 0 ? input_signal[index] : 0.0f;
+        }
+    }
+
+    for (int start = 0; start < output_length; start += MULTIRATE_BLOCK_LENGTH) {
+        int end = MIN(start + MULTIRATE_BLOCK_LENGTH, output_length);
+        memset(output_signal + start, 0, (end - start) * sizeof(float));
+        for (int p = 0; p < kernel.tap_phase_count; ++p) {
+            const float *taps = kernel.taps + (size_t) p * kernel.phase_length;
+            const float *component = components + (size_t) p * output_length;
+            for (int m = 0; m < kernel.phase_length; ++m) {
+                // Components before the start of the signal are zero, so the outputs below m are skipped
+                int first = start > m ? start : m;
+                const float tap = taps[m];
+                for (int k = first; k < end; ++k) {
+                    output_signal[k] += tap * component[k - m];
+                }
+            }
+        }
+    }
+
+    free(components);
+    free(kernel.taps);
+    return 0;
+}
+
+// API endpoint for upsampling and filtering in one pass
+int apply_fir_interpolate(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int factor
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0 || factor <= 0) {
+        fprintf(stderr, "apply_fir_interpolate: Invalid input parameter(s).\n");
+        return -1;
+    }
+    if (signal_length == 0) {
+        return 0;
+    }
+
+    // Only every factor-th sample of the zero-stuffed signal is non-zero, so the output sample
+    // y[k * factor + p] only meets the taps of phase p: y[k * factor + p] = sum_m h[m * factor + p] * x[k - m].
+    // Each phase is a short filter at the input rate, whose output is interleaved into the output signal.
+    PolyphaseKernel kernel;
+    if (split_polyphase(&kernel, filter->coefficients, filter->kernel_length, factor, 0) != 0) {
+        fprintf(stderr, "apply_fir_interpolate: Memory allocation for the polyphase kernel failed.\n");
+        return -1;
+    }
+    float *phase_output = (float *) malloc(MULTIRATE_BLOCK_LENGTH * sizeof(float));
+    if (phase_output == NULL) {
+        fprintf(stderr, "apply_fir_interpolate: Memory allocation for the phase output failed.\n");
+        free(kernel.taps);
+        return -1;
+    }
+
+    for (int start = 0; start < signal_length; start += MULTIRATE_BLOCK_LENGTH) {
+        int end = MIN(start + MULTIRATE_BLOCK_LENGTH, signal_length);
+        for (int p = 0; p < factor; ++p) {
+            memset(phase_output, 0, (end - start) * sizeof(float));
+            // The phases without taps give zero outputs
+            if (p < kernel.tap_phase_count) {
+                const float *taps = kernel.taps + (size_t) p * kernel.phase_length;
+                for (int m = 0; m < kernel.phase_length; ++m) {
+                    // Input samples before the start of the signal are zero, so the outputs below m are skipped
+                    int first = start > m ? start : m;
+                    const float tap = taps[m];
+                    for (int k = first; k < end; ++k) {
+                        phase_output[k - start] += tap * input_signal[k - m];
+                    }
+                }
+            }
+            for (int k = start; k < end; ++k) {
+                output_signal[(size_t) k * factor + p] = phase_output[k - start];
+            }
+        }
+    }
+
+    free(phase_output);
+    free(kernel.taps);
+    return 0;
+}
+
+struct FIRResampler {
+    FIRFilter *filter;          // Anti-aliasing filter at the intermediate rate, including the gain
+    int up_factor;              // Reduced interpolation factor L
+    int down_factor;            // Reduced decimation factor M
+    int phase_length;           // Taps per phase
+    float *reversed_taps;       // Taps of every phase in reversed order, so each output is a forward dot product
+    float *buffer;              // phase_length - 1 samples of history followed by the samples of the current call
+    int buffer_capacity;        // Number of new samples the buffer can hold
+    int phase;                  // Phase of the next output sample, (output time) mod L
+    int next_input;             // Input index of the next output sample, relative to the next call
+};
+
+static int greatest_common_divisor(int a, int b) {
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// API endpoint to create a rational resampler
+FIRResampler *create_fir_resampler(int up_factor, int down_factor, WindowType window, int kernel_length) {
+    // Validate the input parameters
+    if (up_factor <= 0 || down_factor <= 0 || kernel_length < 0) {
+        fprintf(stderr, "create_fir_resampler: Invalid input parameter(s).\n"
+                        "Please ensure that both factors are positive.\n");
+        return NULL;
+    }
+    int divisor = greatest_common_divisor(up_factor, down_factor);
+    up_factor /= divisor;
+    down_factor /= divisor;
+    int max_factor = up_factor > down_factor ? up_factor : down_factor;
+    if (kernel_length == 0) {
+        kernel_length = 32 * max_factor + 1;
+    }
+
+    FIRResampler *resampler = (FIRResampler *) calloc(1, sizeof(FIRResampler));
+    if (resampler == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRResampler\n");
+        return NULL;
+    }
+    resampler->up_factor = up_factor;
+    resampler->down_factor = down_factor;
+
+    // Design the low-pass filter at the intermediate rate L * fs, with the cutoff at the lower Nyquist
+    // frequency min(L, M) * fs / 2 / max(L, M) relative to it. Normalizing the intermediate rate to
+    // 2 * max(L, M) puts the cutoff at 1. The gain L makes up for the zero stuffing.
+    resampler->filter = create_fir_filter(LOW_PASS, window, 1.0f, kernel_length, 2.0f * (float) max_factor);
+    if (resampler->filter == NULL) {
+        fprintf(stderr, "Failed to create the anti-aliasing filter of the FIRResampler\n");
+        destroy_fir_resampler(resampler);
+        return NULL;
+    }
+    for (int j = 0; j < resampler->filter->kernel_length; ++j) {
+        resampler->filter->coefficients[j] *= (float) up_factor;
+    }
+    detect_fir_filter_structure(resampler->filter);
+
+    PolyphaseKernel kernel;
+    if (split_polyphase(&kernel, resampler->filter->coefficients, resampler->filter->kernel_length,
+                        up_factor, 1) != 0) {
+        fprintf(stderr, "Failed to allocate memory for the FIRResampler phases\n");
+        destroy_fir_resampler(resampler);
+        return NULL;
+    }
+    resampler->phase_length = kernel.phase_length;
+    resampler->reversed_taps = kernel.taps;
+    for (int p = 0; p < up_factor; ++p) {
+        float *taps = kernel.taps + p * kernel.phase_length;
+        for (int i = 0, j = kernel.phase_length - 1; i < j; ++i, --j) {
+            float t = taps[i];
+            taps[i] = taps[j];
+            taps[j] = t;
+        }
+    }
+
+    resampler->buffer_capacity = MULTIRATE_BLOCK_LENGTH;
+    resampler->buffer = (float *) calloc(resampler->phase_length - 1 + resampler->buffer_capacity, sizeof(float));
+    if (resampler->buffer == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRResampler history\n");
+        destroy_fir_resampler(resampler);
+        return NULL;
+    }
+    return resampler;
+}
+
+const FIRFilter *fir_resampler_filter(const FIRResampler *resampler) {
+    return resampler != NULL ? resampler->filter : NULL;
+}
+
+int fir_resampler_max_output_length(const FIRResampler *resampler, int input_length) {
+    if (resampler == NULL || input_length <= 0) {
+        return 0;
+    }
+    return (int) (((long long) input_length * resampler->up_factor) / resampler->down_factor) + 1;
+}
+
+// API endpoint for resampling the next samples of a stream
+int process_fir_resampler(
+        FIRResampler *resampler,
+        const float *input_signal,
+        int input_length,
+        float *output_signal
+) {
+    // Check for valid input parameters
+    if (resampler == NULL || input_signal == NULL || output_signal == NULL || input_length < 0) {
+        fprintf(stderr, "process_fir_resampler: Invalid input parameter(s).\n");
+        return -1;
+    }
+
+    int history_length = resampler->phase_length - 1;
+    int output_count = 0;
+    int done = 0;
+    while (done < input_length) {
+        // Append the next chunk of input samples after the history
+        int count = MIN(input_length - done, resampler->buffer_capacity);
+        memcpy(resampler->buffer + history_length, input_signal + done, count * sizeof(float));
+
+        // The output at the intermediate time t = n * M has the phase p = t mod L and meets the
+        // input samples x[t / L - m] with the taps h[m * L + p], which only depend on p
+        while (resampler->next_input < count) {
+            const float *taps = resampler->reversed_taps + resampler->phase * resampler->phase_length;
+            const float *x = resampler->buffer + resampler->next_input;
+            float sum = 0.0f;
+            for (int i = 0; i < resampler->phase_length; ++i) {
+                sum += taps[i] * x[i];
+            }
+            output_signal[output_count++] = sum;
+
+            resampler->phase += resampler->down_factor;
+            resampler->next_input += resampler->phase / resampler->up_factor;
+            resampler->phase %= resampler->up_factor;
+        }
+        resampler->next_input -= count;
+
+        // Keep the last phase_length - 1 samples as the history of the next chunk
+        memmove(resampler->buffer, resampler->buffer + count, history_length * sizeof(float));
+        done += count;
+    }
+    return output_count;
+}
+
+void reset_fir_resampler(FIRResampler *resampler) {
+    if (resampler == NULL) return;
+    memset(resampler->buffer, 0, (resampler->phase_length - 1 + resampler->buffer_capacity) * sizeof(float));
+    resampler->phase = 0;
+    resampler->next_input = 0;
+}
+
+// API endpoint to free the memory held by the resampler
+void destroy_fir_resampler(FIRResampler *resampler) {
+    if (resampler != NULL) {
+        destroy_fir_filter(resampler->filter);
+        free(resampler->reversed_taps);
+        free(resampler->buffer);
+        free(resampler);
+    }
+}
@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "fir_parallel.h"
+#include "fir_filter_internal.h"
+
+// Number of chunks per thread, more chunks than threads balance threads which are interrupted by other work
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+struct FIRThreadPool {
+    int thread_count;           // Number of threads, including the calling thread
+    pthread_t *threads;         // Worker threads
+    int started_count;          // Number of worker threads which were started
+    pthread_mutex_t run_mutex;  // Serializes the batches of concurrent callers
+    pthread_mutex_t mutex;      // Protects the batch state below
+    pthread_cond_t work_cond;   // Signals a new batch or the stop request to the workers
+    pthread_cond_t done_cond;   // Signals the end of a batch to the caller
+    void (*task)(void *context, int index);
+    void *context;
+    int task_count;             // Number of tasks of the current batch
+    int next_task;              // Next task to be taken
+    int finished_count;         // Number of finished tasks of the current batch
+    long long batch;            // Number of the current batch, the workers wait for it to change
+    int stop;                   // Asks the worker threads to exit
+};
+
+// Take and run the tasks of the current batch until none is left. Called with the mutex locked.
+static void run_batch_tasks(FIRThreadPool *pool) {
+    while (pool->next_task < pool->task_count) {
+        int index = pool->next_task++;
+        pthread_mutex_unlock(&pool->mutex);
+        pool->task(pool->context, index);
+        pthread_mutex_lock(&pool->mutex);
+        if (++pool->finished_count == pool->task_count) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+}
+
+static void *pool_worker(void *argument) {
+    FIRThreadPool *pool = (FIRThreadPool *) argument;
+    long long seen_batch = 0;
+    pthread_mutex_lock(&pool->mutex);
+    while (1) {
+        while (!pool->stop && pool->batch == seen_batch) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->stop) {
+            break;
+        }
+        seen_batch = pool->batch;
+        run_batch_tasks(pool);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+FIRThreadPool *create_fir_thread_pool(int thread_count) {
+    // Validate the input parameters
+    if (thread_count < 0) {
+        fprintf(stderr, "create_fir_thread_pool: Invalid input parameter(s).\n");
+        return NULL;
+    }
+    if (thread_count == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = processors > 0 ? (int) processors : 1;
+    }
+
+    FIRThreadPool *pool = (FIRThreadPool *) calloc(1, sizeof(FIRThreadPool));
+    if (pool == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRThreadPool\n");
+        return NULL;
+    }
+    pool->thread_count = thread_count;
+    pthread_mutex_init(&pool->run_mutex, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    pool->threads = (pthread_t *) malloc(thread_count * sizeof(pthread_t));
+    if (pool->threads == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRThreadPool threads\n");
+        destroy_fir_thread_pool(pool);
+        return NULL;
+    }
+    for (int t = 0; t < thread_count - 1; ++t) {
+        if (pthread_create(&pool->threads[t], NULL, pool_worker, pool) != 0) {
+            fprintf(stderr, "Failed to start the FIRThreadPool worker threads\n");
+            destroy_fir_thread_pool(pool);
+            return NULL;
+        }
+        pool->started_count++;
+    }
+    return pool;
+}
+
+int fir_thread_pool_size(const FIRThreadPool *pool) {
+    return pool != NULL ? pool->thread_count : 0;
+}
+
+void run_fir_thread_pool(FIRThreadPool *pool, int task_count, void (*task)(void *context, int index), void *context) {
+    pthread_mutex_lock(&pool->run_mutex);
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->context = context;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pool->finished_count = 0;
+    pool->batch++;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    // The calling thread takes tasks as well, then waits for the tasks still running on the workers
+    run_batch_tasks(pool);
+    while (pool->finished_count < pool->task_count) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->run_mutex);
+}
+
+// One parallel apply call, every task computes one chunk of the output
+typedef struct {
+    const FIRFilter *filter;
+    const float *input_signal;
+    float *output_signal;
+    int signal_length;
+    int chunk_length;
+    int use_simd;
+    FIRSimdLevel level;
+} ParallelApply;
+
+static void apply_chunk(void *context, int index) {
+    const ParallelApply *apply = (const ParallelApply *) context;
+    int begin = index * apply->chunk_length;
+    int end = MIN(begin + apply->chunk_length, apply->signal_length);
+    // The chunk reads the input from begin - (kernel_length - 1) on, which is shared with the previous chunk
+    if (apply->use_simd) {
+        apply_fir_filter_simd_range(apply->level, apply->filter, apply->input_signal, apply->output_signal,
+                                    begin, end);
+    } else {
+        apply_fir_filter_range(apply->filter, apply->input_signal, apply->output_signal, begin, end);
+    }
+}
+
+static void apply_parallel(FIRThreadPool *pool, FIRFilter *filter, const float *input_signal, float *output_signal,
+                           int signal_length, int use_simd) {
+    // Cut the output into chunks of similar length, but not shorter than the minimum chunk length
+    long long max_chunk_count = (long long) pool->thread_count * PARALLEL_CHUNKS_PER_THREAD;
+    long long chunk_count = ((long long) signal_length + PARALLEL_MIN_CHUNK_LENGTH - 1) / PARALLEL_MIN_CHUNK_LENGTH;
+    chunk_count = MIN(chunk_count, max_chunk_count);
+    if (chunk_count <= 1) {
+        chunk_count = 1;
+    }
+
+    ParallelApply apply;
+    apply.filter = filter;
+    apply.input_signal = input_signal;
+    apply.output_signal = output_signal;
+    apply.signal_length = signal_length;
+    apply.chunk_length = (int) ((signal_length + chunk_count - 1) / chunk_count);
+    apply.use_simd = use_simd;
+    apply.level = fir_simd_detect();
+
+    if (chunk_count == 1 || pool->thread_count == 1) {
+        apply.chunk_length = signal_length;
+        apply_chunk(&apply, 0);
+        return;
+    }
+    run_fir_thread_pool(pool, (int) chunk_count, apply_chunk, &apply);
+}
+
+// API endpoint for applying the filter on the threads of a pool
+void apply_fir_filter_parallel(
+        FIRThreadPool *pool,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (pool == NULL || filter == NULL || filter->coefficients == NULL || input_signal == NULL ||
+        output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_parallel: Invalid input parameter(s).\n");
+        return;
+    }
+
+    apply_parallel(pool, filter, input_signal, output_signal, signal_length, 0);
+}
+
+// API endpoint for applying the filter with the vectorized kernels on the threads of a pool
+void apply_fir_filter_simd_parallel(
+        FIRThreadPool *pool,
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (pool == NULL || filter == NULL || filter->coefficients == NULL || input_signal == NULL ||
+        output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_simd_parallel: Invalid input parameter(s).\n");
+        return;
+    }
+
+    apply_parallel(pool, filter, input_signal, output_signal, signal_length, 1);
+}
+
+// API endpoint to stop the worker threads and free the memory held by the pool
+void destroy_fir_thread_pool(FIRThreadPool *pool) {
+    if (pool != NULL) {
+        pthread_mutex_lock(&pool->mutex);
+        pool->stop = 1;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->mutex);
+        for (int t = 0; t < pool->started_count; ++t) {
+            pthread_join(pool->threads[t], NULL);
+        }
+        pthread_mutex_destroy(&pool->run_mutex);
+        pthread_mutex_destroy(&pool->mutex);
+        pthread_cond_destroy(&pool->work_cond);
+        pthread_cond_destroy(&pool->done_cond);
+        free(pool->threads);
+        free(pool);
+    }
+}
@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "fir_partitioned.h"
+#include "fir_filter_internal.h"
+#include "fft.h"
+
+// Largest block length of the non-uniform partitions, the last partition level
+// takes the rest of the kernel with as many partitions of this length as needed
+#define NONUNIFORM_MAX_BLOCK_LENGTH 8192
+
+// Uniformly partitioned overlap-save convolution of one stream with a (sub-)kernel.
+// Each partition of block_length taps is transformed with 2 * block_length points, and
+// the spectra of the last partition_count input blocks are kept in a circular frequency-domain delay line.
+typedef struct {
+    FFTPlan *fft;               // Transform of 2 * block_length samples
+    int block_length;           // Samples per block
+    int partition_count;        // Number of kernel partitions
+    int spectrum_length;        // Floats per spectrum (2 * block_length + 2)
+    float *kernel_spectra;      // Spectra of the kernel partitions
+    float *delay_line;          // Spectra of the last partition_count input blocks
+    int delay_line_position;    // Slot of the most recent input block in the delay line
+    float *window;              // Previous and current input block
+    float *accumulator;         // Sum of the partition products
+    float *block;               // Work buffer for the inverse transform
+} PartitionedCore;
+
+struct FIRPartitionedConvolver {
+    PartitionedCore core;
+};
+
+static void destroy_partitioned_core(PartitionedCore *core) {
+    destroy_fft_plan(core->fft);
+    free(core->kernel_spectra);
+    free(core->delay_line);
+    free(core->window);
+    free(core->accumulator);
+    free(core->block);
+}
+
+static void reset_partitioned_core(PartitionedCore *core) {
+    memset(core->delay_line, 0, core->partition_count * core->spectrum_length * sizeof(float));
+    memset(core->window, 0, 2 * core->block_length * sizeof(float));
+    core->delay_line_position = 0;
+}
+
+// Initialize the core for the kernel coefficients[0 .. length), returns 0 on success
+static int init_partitioned_core(PartitionedCore *core, const float *coefficients, int length, int block_length) {
+    memset(core, 0, sizeof(PartitionedCore));
+    int fft_size = 2 * block_length;
+    core->block_length = block_length;
+    core->partition_count = (length + block_length - 1) / block_length;
+    core->spectrum_length = fft_size + 2;
+
+    core->fft = create_fft_plan(fft_size);
+    core->kernel_spectra = (float *) malloc(core->partition_count * core->spectrum_length * sizeof(float));
+    core->delay_line = (float *) malloc(core->partition_count * core->spectrum_length * sizeof(float));
+    core->window = (float *) malloc(fft_size * sizeof(float));
+    core->accumulator = (float *) malloc(core->spectrum_length * sizeof(float));
+    core->block = (float *) malloc(fft_size * sizeof(float));
+    if (core->fft == NULL || core->kernel_spectra == NULL || core->delay_line == NULL || core->window == NULL ||
+        core->accumulator == NULL || core->block == NULL) {
+        destroy_partitioned_core(core);
+        return -1;
+    }
+
+    // Transform every zero-padded partition of the kernel once
+    for (int p = 0; p < core->partition_count; ++p) {
+        int count = MIN(block_length, length - p * block_length);
+        memset(core->block, 0, fft_size * sizeof(float));
+        memcpy(core->block, coefficients + p * block_length, count * sizeof(float));
+        fft_forward(core->fft, core->block, core->kernel_spectra + p * core->spectrum_length);
+    }
+
+    reset_partitioned_core(core);
+    return 0;
+}
+
+// Filter exactly one block of block_length samples
+static void process_partitioned_block(PartitionedCore *core, const float *input_block, float *output_block) {
+    int block_length = core->block_length;
+
+    // Slide the input window by one block and store the spectrum of the window in the delay line
+    memmove(core->window, core->window + block_length, block_length * sizeof(float));
+    memcpy(core->window + block_length, input_block, block_length * sizeof(float));
+    core->delay_line_position = (core->delay_line_position + 1) % core->partition_count;
+    fft_forward(core->fft, core->window, core->delay_line + core->delay_line_position * core->spectrum_length);
+
+    // The p-th partition of the kernel meets the input block that arrived p blocks ago
+    memset(core->accumulator, 0, core->spectrum_length * sizeof(float));
+    for (int p = 0; p < core->partition_count; ++p) {
+        int slot = (core->delay_line_position - p + core->partition_count) % core->partition_count;
+        fft_multiply_accumulate(core->delay_line + slot * core->spectrum_length,
+                                core->kernel_spectra + p * core->spectrum_length,
+                                core->accumulator, block_length + 1);
+    }
+
+    // The first half of the circular convolution is aliased, the second half is the output of the block
+    fft_inverse(core->fft, core->accumulator, core->block);
+    memcpy(output_block, core->block + block_length, block_length * sizeof(float));
+}
+
+
+// API endpoint to create a uniformly partitioned convolver
+FIRPartitionedConvolver *create_fir_partitioned_convolver(const FIRFilter *filter, int block_length) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 ||
+        block_length <= 0 || (block_length & (block_length - 1)) != 0) {
+        fprintf(stderr, "create_fir_partitioned_convolver: Invalid input parameter(s).\n"
+                        "Please ensure that the filter is valid and the block length is a power of two.\n");
+        return NULL;
+    }
+
+    FIRPartitionedConvolver *convolver = (FIRPartitionedConvolver *) malloc(sizeof(FIRPartitionedConvolver));
+    if (convolver == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRPartitionedConvolver\n");
+        return NULL;
+    }
+
+    if (init_partitioned_core(&convolver->core, filter->coefficients, filter->kernel_length, block_length) != 0) {
+        fprintf(stderr, "Failed to allocate memory for the FIRPartitionedConvolver buffers\n");
+        free(convolver);
+        return NULL;
+    }
+    return convolver;
+}
+
+int fir_partitioned_convolver_block_length(const FIRPartitionedConvolver *convolver) {
+    return convolver != NULL ? convolver->core.block_length : 0;
+}
+
+// API endpoint for filtering the next blocks of a stream
+void process_fir_partitioned_convolver(
+        FIRPartitionedConvolver *convolver,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (convolver == NULL || input_signal == NULL || output_signal == NULL || signal_length < 0 ||
+        signal_length % convolver->core.block_length != 0) {
+        fprintf(stderr, "process_fir_partitioned_convolver: Invalid input parameter(s).\n"
+                        "Please ensure that the signal length is a multiple of the block length.\n");
+        return;
+    }
+
+    for (int start = 0; start < signal_length; start += convolver->core.block_length) {
+        process_partitioned_block(&convolver->core, input_signal + start, output_signal + start);
+    }
+}
+
+void reset_fir_partitioned_convolver(FIRPartitionedConvolver *convolver) {
+    if (convolver != NULL) {
+        reset_partitioned_core(&convolver->core);
+    }
+}
+
+// API endpoint to free the memory held by the convolver
+void destroy_fir_partitioned_convolver(FIRPartitionedConvolver *convolver) {
+    if (convolver != NULL) {
+        destroy_partitioned_core(&convolver->core);
+        free(convolver);
+    }
+}
+
+
+// One level of the non-uniform partitioning: a uniformly partitioned convolution of the taps
+// [offset, offset + length) with its own block length. A level whose offset is at least twice its
+// block length has a full block period of slack before its output is due, and runs on a worker thread.
+typedef struct {
+    PartitionedCore core;       // Convolution of the level's taps
+    int offset;                 // First tap of the level
+    int block_length;           // Block length of the level
+    int is_async;               // Whether the level is computed by a worker thread
+    float *input_block;         // Input samples gathered for the current block
+    float *job_input;           // Input block handed over to the worker thread
+    float *job_output;          // Output block computed by the worker thread
+    long long job_time;         // Stream time of the first output sample of the job
+    int has_job;                // Whether a job was submitted and its output was not collected yet
+    int job_pending;            // Whether the worker thread has not finished the job yet
+    int stop;                   // Asks the worker thread to exit
+    int has_thread;             // Whether the worker thread was started
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} NonUniformLevel;
+
+struct FIRNonUniformConvolver {
+    float *head;                // Direct-form head coefficients
+    int head_length;            // Number of head taps, also the smallest block length
+    float *head_window;         // Last head_length - 1 input samples followed by the current chunk
+    NonUniformLevel *levels;    // FFT partition levels
+    int level_count;            // Number of FFT partition levels
+    float *future;              // Circular buffer of the level outputs which are not due yet
+    int future_length;          // Length of the circular buffer (power of two)
+    long long position;         // Number of samples processed since the start of the stream
+};
+
+static void *nonuniform_worker(void *argument) {
+    NonUniformLevel *level = (NonUniformLevel *) argument;
+    pthread_mutex_lock(&level->mutex);
+    for (;;) {
+        while (!level->job_pending && !level->stop) {
+            pthread_cond_wait(&level->cond, &level->mutex);
+        }
+        if (level->stop) break;
+        pthread_mutex_unlock(&level->mutex);
+
+        process_partitioned_block(&level->core, level->job_input, level->job_output);
+
+        pthread_mutex_lock(&level->mutex);
+        level->job_pending = 0;
+        pthread_cond_broadcast(&level->cond);
+    }
+    pthread_mutex_unlock(&level->mutex);
+    return NULL;
+}
+
+// Add a block of level output to the circular buffer of future output samples
+static void add_to_future(FIRNonUniformConvolver *convolver, long long time, const float *block, int length) {
+    int mask = convolver->future_length - 1;
+    for (int i = 0; i < length; ++i) {
+        convolver->future[(time + i) & mask] += block[i];
+    }
+}
+
+// Wait for the worker thread of a level and collect the output of its last job
+static void collect_level_job(FIRNonUniformConvolver *convolver, NonUniformLevel *level) {
+    if (!level->has_job) return;
+    pthread_mutex_lock(&level->mutex);
+    while (level->job_pending) {
+        pthread_cond_wait(&level->cond, &level->mutex);
+    }
+    pthread_mutex_unlock(&level->mutex);
+    add_to_future(convolver, level->job_time, level->job_output, level->block_length);
+    level->has_job = 0;
+}
+
+// Called when the input block of a level is complete, block_start is the stream time of its first sample
+static void complete_level_block(FIRNonUniformConvolver *convolver, NonUniformLevel *level, long long block_start) {
+    long long output_time = block_start + level->offset;
+    if (!level->is_async) {
+        // The output of the block is due after offset >= block_length samples, i.e. from now on
+        process_partitioned_block(&level->core, level->input_block, level->job_output);
+        add_to_future(convolver, output_time, level->job_output, level->block_length);
+        return;
+    }
+
+    // The previous job's output is due one block period from now, the new job has a full period to finish
+    collect_level_job(convolver, level);
+    memcpy(level->job_input, level->input_block, level->block_length * sizeof(float));
+    level->job_time = output_time;
+    level->has_job = 1;
+    pthread_mutex_lock(&level->mutex);
+    level->job_pending = 1;
+    pthread_cond_broadcast(&level->cond);
+    pthread_mutex_unlock(&level->mutex);
+}
+
+// API endpoint to create a non-uniformly partitioned convolver
+FIRNonUniformConvolver *create_fir_nonuniform_convolver(const FIRFilter *filter, int head_length) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0 ||
+        head_length <= 0 || (head_length & (head_length - 1)) != 0) {
+        fprintf(stderr, "create_fir_nonuniform_convolver: Invalid input parameter(s).\n"
+                        "Please ensure that the filter is valid and the head length is a power of two.\n");
+        return NULL;
+    }
+
+    FIRNonUniformConvolver *convolver = (FIRNonUniformConvolver *) calloc(1, sizeof(FIRNonUniformConvolver));
+    if (convolver == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRNonUniformConvolver\n");
+        return NULL;
+    }
+
+    // Plan the partition levels. The first level starts right after the head with the head's block length,
+    // so its offset equals its block length and it is computed synchronously with three partitions.
+    // Every following level doubles the block length and starts at twice its block length, which leaves
+    // a full block period for its worker thread.
+    int kernel_length = filter->kernel_length;
+    int level_offsets[32], level_lengths[32], level_blocks[32];
+    int level_count = 0;
+    int offset = MIN(head_length, kernel_length);
+    int block_length = head_length;
+    while (offset < kernel_length) {
+        int partitions = level_count == 0 ? 3 : 2;
+        int remaining = kernel_length - offset;
+        int length = remaining;
+        if (remaining > partitions * block_length && block_length < NONUNIFORM_MAX_BLOCK_LENGTH && level_count < 31) {
+            length = partitions * block_length;
+        }
+        level_offsets[level_count] = offset;
+        level_lengths[level_count] = length;
+        level_blocks[level_count] = block_length;
+        ++level_count;
+        offset += length;
+        block_length = MIN(2 * block_length, NONUNIFORM_MAX_BLOCK_LENGTH);
+    }
+
+    convolver->head_length = head_length;
+    convolver->level_count = level_count;
+    convolver->head = (float *) calloc(head_length, sizeof(float));
+    convolver->head_window = (float *) calloc(2 * head_length, sizeof(float));
+    convolver->levels = (NonUniformLevel *) calloc(MAX(level_count, 1), sizeof(NonUniformLevel));
+    convolver->future_length = fft_next_size(kernel_length + 2 * MAX(head_length, NONUNIFORM_MAX_BLOCK_LENGTH));
+    convolver->future = (float *) calloc(convolver->future_length, sizeof(float));
+    if (convolver->head == NULL || convolver->head_window == NULL || convolver->levels == NULL ||
+        convolver->future == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRNonUniformConvolver buffers\n");
+        destroy_fir_nonuniform_convolver(convolver);
+        return NULL;
+    }
+    memcpy(convolver->head, filter->coefficients, MIN(head_length, kernel_length) * sizeof(float));
+
+    for (int i = 0; i < level_count; ++i) {
+        NonUniformLevel *level = &convolver->levels[i];
+        level->offset = level_offsets[i];
+        level->block_length = level_blocks[i];
+        level->is_async = level->offset >= 2 * level->block_length;
+        level->input_block = (float *) malloc(level->block_length * sizeof(float));
+        level->job_input = (float *) malloc(level->block_length * sizeof(float));
+        level->job_output = (float *) malloc(level->block_length * sizeof(float));
+        if (level->input_block == NULL || level->job_input == NULL || level->job_output == NULL ||
+            init_partitioned_core(&level->core, filter->coefficients + level->offset, level_lengths[i],
+                                  level->block_length) != 0) {
+            fprintf(stderr, "Failed to allocate memory for the FIRNonUniformConvolver partitions\n");
+            destroy_fir_nonuniform_convolver(convolver);
+            return NULL;
+        }
+
+        if (level->is_async) {
+            pthread_mutex_init(&level->mutex, NULL);
+            pthread_cond_init(&level->cond, NULL);
+            if (pthread_create(&level->thread, NULL, nonuniform_worker, level) != 0) {
+                fprintf(stderr, "Failed to start a worker thread for the FIRNonUniformConvolver\n");
+                pthread_mutex_destroy(&level->mutex);
+                pthread_cond_destroy(&level->cond);
+                destroy_fir_nonuniform_convolver(convolver);
+                return NULL;
+            }
+            level->has_thread = 1;
+        }
+    }
+
+    return convolver;
+}
+
+// API endpoint for filtering the next samples of a stream
+void process_fir_nonuniform_convolver(
+        FIRNonUniformConvolver *convolver,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (convolver == NULL || input_signal == NULL || output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "process_fir_nonuniform_convolver: Invalid input parameter(s).\n");
+        return;
+    }
+
+    int head_length = convolver->head_length;
+    int history_length = head_length - 1;
+    int mask = convolver->future_length - 1;
+    int done = 0;
+    while (done < signal_length) {
+        // Process the samples up to the next boundary of the smallest block length,
+        // the blocks of all levels are complete only at such boundaries
+        int count = MIN(signal_length - done, head_length - (int) (convolver->position % head_length));
+        const float *input = input_signal + done;
+        float *output = output_signal + done;
+
+        // Direct-form head on the window of the last head_length - 1 samples and the new samples
+        memcpy(convolver->head_window + history_length, input, count * sizeof(float));
+        for (int i = 0; i < count; ++i) {
+            const float *newest = convolver->head_window + history_length + i;
+            float sum = 0.0f;
+            for (int j = 0; j < head_length; ++j) {
+                sum += convolver->head[j] * newest[-j];
+            }
+            // Add the tail contributions computed by the partition levels
+            float *future = &convolver->future[(convolver->position + i) & mask];
+            output[i] = sum + *future;
+            *future = 0.0f;
+        }
+        memmove(convolver->head_window, convolver->head_window + count, history_length * sizeof(float));
+
+        // Gather the input of every level and start the levels whose block is complete
+        for (int l = 0; l < convolver->level_count; ++l) {
+            NonUniformLevel *level = &convolver->levels[l];
+            int fill = (int) (convolver->position % level->block_length);
+            memcpy(level->input_block + fill, input, count * sizeof(float));
+        }
+        convolver->position += count;
+        for (int l = 0; l < convolver->level_count; ++l) {
+            NonUniformLevel *level = &convolver->levels[l];
+            if (convolver->position % level->block_length == 0) {
+                complete_level_block(convolver, level, convolver->position - level->block_length);
+            }
+        }
+
+        done += count;
+    }
+}
+
+void reset_fir_nonuniform_convolver(FIRNonUniformConvolver *convolver) {
+    if (convolver == NULL) return;
+    for (int l = 0; l < convolver->level_count; ++l) {
+        NonUniformLevel *level = &convolver->levels[l];
+        collect_level_job(convolver, level);
+        reset_partitioned_core(&level->core);
+    }
+    memset(convolver->head_window, 0, 2 * convolver->head_length * sizeof(float));
+    memset(convolver->future, 0, convolver->future_length * sizeof(float));
+    convolver->position = 0;
+}
+
+// API endpoint to stop the worker threads and free the memory held by the convolver
+void destroy_fir_nonuniform_convolver(FIRNonUniformConvolver *convolver) {
+    if (convolver == NULL) return;
+    if (convolver->levels != NULL) {
+        for (int l = 0; l < convolver->level_count; ++l) {
+            NonUniformLevel *level = &convolver->levels[l];
+            if (level->has_thread) {
+                pthread_mutex_lock(&level->mutex);
+                level->stop = 1;
+                pthread_cond_broadcast(&level->cond);
+                pthread_mutex_unlock(&level->mutex);
+                pthread_join(level->thread, NULL);
+                pthread_mutex_destroy(&level->mutex);
+                pthread_cond_destroy(&level->cond);
+            }
+            destroy_partitioned_core(&level->core);
+            free(level->input_block);
+            free(level->job_input);
+            free(level->job_output);
+        }
+    }
+    free(convolver->head);
+    free(convolver->head_window);
+    free(convolver->levels);
+    free(convolver->future);
+    free(convolver);
+}
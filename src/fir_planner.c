@@ -0,0 +1,423 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "fir_planner.h"
+#include "fir_filter_internal.h"
+#include "fir_filter_fft.h"
+#include "fir_partitioned.h"
+#include "fir_tiled.h"
+#include "fft.h"
+
+#define PLANNER_ENGINE_COUNT 5
+#define PLANNER_GRID_SIZE 6
+
+// Partition lengths of the partitioned engine: the longest power of two within the latency budget,
+// and the one used without a latency budget and for the calibration
+#define PLANNER_MIN_PARTITION_LENGTH 32
+#define PLANNER_MAX_PARTITION_LENGTH 8192
+#define PLANNER_PARTITION_LENGTH 256
+
+// Kernel length from which the tiled engine beats the vectorized kernels without wisdom
+#define PLANNER_TILED_MIN_LENGTH 4096
+
+// Signal length of the calibration, and the longest kernel the scalar direct engine is timed on
+#define PLANNER_CALIBRATION_SIGNAL_LENGTH 16384
+#define PLANNER_CALIBRATION_MAX_DIRECT_LENGTH 1024
+
+// Kernel lengths the engines are timed on, other lengths are estimated from the nearest one
+static const int planner_grid[PLANNER_GRID_SIZE] = {16, 64, 256, 1024, 4096, 16384};
+
+static const char *engine_names[PLANNER_ENGINE_COUNT] = {"direct", "simd", "tiled", "fft", "partitioned"};
+
+// Measured run time of an engine for one kernel length, a sample time of zero means not measured
+typedef struct {
+    double setup_seconds;       // Time to create and destroy the engine's plan
+    double sample_seconds;      // Time per output sample
+} EngineCost;
+
+static EngineCost wisdom[PLANNER_GRID_SIZE][PLANNER_ENGINE_COUNT];
+static int has_wisdom = 0;
+static pthread_mutex_t wisdom_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+const char *fir_engine_name(FIREngine engine) {
+    if ((int) engine < 0 || (int) engine >= PLANNER_ENGINE_COUNT) {
+        return "unknown";
+    }
+    return engine_names[engine];
+}
+
+// Number of output samples per transform of an FFT plan with the default block length
+static int fft_engine_block_length(int kernel_length) {
+    return fft_next_size(MAX(kernel_length, 64) + kernel_length - 1) - kernel_length + 1;
+}
+
+// Partition length of the partitioned engine for a latency budget, or 0 if the budget is too small
+static int partition_length_for_budget(int latency_budget) {
+    if (latency_budget < 0) {
+        return PLANNER_PARTITION_LENGTH;
+    }
+    if (latency_budget < PLANNER_MIN_PARTITION_LENGTH) {
+        return 0;
+    }
+    int partition_length = PLANNER_MIN_PARTITION_LENGTH;
+    while (partition_length * 2 <= MIN(latency_budget, PLANNER_MAX_PARTITION_LENGTH)) {
+        partition_length *= 2;
+    }
+    return partition_length;
+}
+
+// Whether the block latency of an engine fits in the latency budget
+static int engine_fits_budget(FIREngine engine, int kernel_length, int latency_budget) {
+    if (latency_budget < 0) {
+        return 1;
+    }
+    switch (engine) {
+        case FIR_ENGINE_FFT:
+            return fft_engine_block_length(kernel_length) <= latency_budget;
+        case FIR_ENGINE_PARTITIONED:
+            return partition_length_for_budget(latency_budget) > 0;
+        default:
+            return 1;
+    }
+}
+
+// Estimated run time of an engine from the wisdom of the grid length nearest to kernel_length (on a log scale),
+// or a negative value if the engine was not measured there. The direct engines scale with the kernel length,
+// the transforms with its logarithm, and the partitioned engine with its number of partitions.
+static double estimate_engine_seconds(FIREngine engine, int kernel_length, int signal_length, int partition_length) {
+    int nearest = 0;
+    for (int g = 1; g < PLANNER_GRID_SIZE; ++g) {
+        if (fabs(log2((double) kernel_length / planner_grid[g])) <
+            fabs(log2((double) kernel_length / planner_grid[nearest]))) {
+            nearest = g;
+        }
+    }
+    EngineCost cost = wisdom[nearest][engine];
+    if (cost.sample_seconds <= 0.0) {
+        return -1.0;
+    }
+
+    double length = kernel_length;
+    double grid_length = planner_grid[nearest];
+    double sample_scale = length / grid_length;
+    if (engine == FIR_ENGINE_FFT) {
+        sample_scale = log2(4.0 * length) / log2(4.0 * grid_length);
+    } else if (engine == FIR_ENGINE_PARTITIONED) {
+        sample_scale = (length / partition_length + log2(2.0 * partition_length)) /
+                       (grid_length / PLANNER_PARTITION_LENGTH + log2(2.0 * PLANNER_PARTITION_LENGTH));
+    }
+    return cost.setup_seconds * length / grid_length + cost.sample_seconds * sample_scale * signal_length;
+}
+
+// The engine choice without wisdom, from crossover lengths measured on typical machines of each level
+static FIREngine plan_without_wisdom(int kernel_length, int signal_length, int latency_budget) {
+    int fft_min_length;
+    switch (fir_simd_detect()) {
+        case FIR_SIMD_AVX512:
+            fft_min_length = 2048;
+            break;
+        case FIR_SIMD_AVX2:
+            fft_min_length = 512;
+            break;
+        case FIR_SIMD_SSE41:
+            fft_min_length = 256;
+            break;
+        default:
+            fft_min_length = 64;
+            break;
+    }
+
+    // The transforms only pay off when the signal is long enough to amortize the transform of the kernel
+    if (kernel_length >= fft_min_length && signal_length >= kernel_length) {
+        if (engine_fits_budget(FIR_ENGINE_FFT, kernel_length, latency_budget)) {
+            return FIR_ENGINE_FFT;
+        }
+        if (engine_fits_budget(FIR_ENGINE_PARTITIONED, kernel_length, latency_budget)) {
+            return FIR_ENGINE_PARTITIONED;
+        }
+    }
+    return kernel_length >= PLANNER_TILED_MIN_LENGTH ? FIR_ENGINE_TILED : FIR_ENGINE_SIMD;
+}
+
+FIREngine fir_plan_engine(int kernel_length, int signal_length, int latency_budget) {
+    kernel_length = MAX(kernel_length, 1);
+    signal_length = MAX(signal_length, 0);
+
+    pthread_mutex_lock(&wisdom_mutex);
+    FIREngine best = FIR_ENGINE_SIMD;
+    if (has_wisdom) {
+        double best_seconds = -1.0;
+        int partition_length = partition_length_for_budget(latency_budget);
+        for (int e = 0; e < PLANNER_ENGINE_COUNT; ++e) {
+            if (!engine_fits_budget((FIREngine) e, kernel_length, latency_budget)) {
+                continue;
+            }
+            double seconds = estimate_engine_seconds((FIREngine) e, kernel_length, signal_length, partition_length);
+            if (seconds >= 0.0 && (best_seconds < 0.0 || seconds < best_seconds)) {
+                best_seconds = seconds;
+                best = (FIREngine) e;
+            }
+        }
+    } else {
+        best = plan_without_wisdom(kernel_length, signal_length, latency_budget);
+    }
+    pthread_mutex_unlock(&wisdom_mutex);
+    return best;
+}
+
+// Run one engine, falling back to the vectorized kernels if its plan cannot be created
+static void run_engine(FIREngine engine, FIRFilter *filter, const float *input_signal, float *output_signal,
+                       int signal_length, int partition_length) {
+    if (engine == FIR_ENGINE_DIRECT) {
+        apply_fir_filter(filter, input_signal, output_signal, signal_length);
+        return;
+    }
+    if (engine == FIR_ENGINE_TILED) {
+        apply_fir_filter_tiled(filter, input_signal, output_signal, signal_length, 0);
+        return;
+    }
+    if (engine == FIR_ENGINE_FFT) {
+        FIRFFTPlan *plan = create_fir_fft_plan(filter, 0);
+        if (plan != NULL) {
+            apply_fir_fft_plan(plan, input_signal, output_signal, signal_length);
+            destroy_fir_fft_plan(plan);
+            return;
+        }
+    }
+    if (engine == FIR_ENGINE_PARTITIONED) {
+        FIRPartitionedConvolver *convolver = create_fir_partitioned_convolver(filter, partition_length);
+        float *block = (float *) calloc(2 * partition_length, sizeof(float));
+        if (convolver != NULL && block != NULL) {
+            // Whole partitions are processed in place, the last partial partition is padded with zeros
+            int whole_length = signal_length - signal_length % partition_length;
+            process_fir_partitioned_convolver(convolver, input_signal, output_signal, whole_length);
+            if (whole_length < signal_length) {
+                memcpy(block, input_signal + whole_length, (signal_length - whole_length) * sizeof(float));
+                process_fir_partitioned_convolver(convolver, block, block + partition_length, partition_length);
+                memcpy(output_signal + whole_length, block + partition_length,
+                       (signal_length - whole_length) * sizeof(float));
+            }
+            destroy_fir_partitioned_convolver(convolver);
+            free(block);
+            return;
+        }
+        destroy_fir_partitioned_convolver(convolver);
+        free(block);
+    }
+    apply_fir_filter_simd(filter, input_signal, output_signal, signal_length);
+}
+
+// API endpoint for applying the filter with the engine chosen by the planner
+void apply_fir_filter_planned(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int latency_budget
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0) {
+        fprintf(stderr, "apply_fir_filter_planned: Invalid input parameter(s).\n");
+        return;
+    }
+
+    FIREngine engine = fir_plan_engine(filter->kernel_length, signal_length, latency_budget);
+    run_engine(engine, filter, input_signal, output_signal, signal_length,
+               partition_length_for_budget(latency_budget));
+}
+
+// Best of three runs of an engine, in seconds
+static double time_engine(FIREngine engine, FIRFilter *filter, const float *input_signal, float *output_signal,
+                          int signal_length) {
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        double start = fir_monotonic_seconds();
+        run_engine(engine, filter, input_signal, output_signal, signal_length, PLANNER_PARTITION_LENGTH);
+        double seconds = fir_monotonic_seconds() - start;
+        best = (run == 0 || seconds < best) ? seconds : best;
+    }
+    return best;
+}
+
+// Best of three plan creations of a transform engine, in seconds
+static double time_engine_setup(FIREngine engine, FIRFilter *filter) {
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        double start = fir_monotonic_seconds();
+        if (engine == FIR_ENGINE_FFT) {
+            destroy_fir_fft_plan(create_fir_fft_plan(filter, 0));
+        } else {
+            destroy_fir_partitioned_convolver(create_fir_partitioned_convolver(filter, PLANNER_PARTITION_LENGTH));
+        }
+        double seconds = fir_monotonic_seconds() - start;
+        best = (run == 0 || seconds < best) ? seconds : best;
+    }
+    return best;
+}
+
+void fir_planner_calibrate(void) {
+    int signal_length = PLANNER_CALIBRATION_SIGNAL_LENGTH;
+    float *input_signal = (float *) malloc(signal_length * sizeof(float));
+    float *output_signal = (float *) malloc(signal_length * sizeof(float));
+    if (input_signal == NULL || output_signal == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the planner calibration\n");
+        free(input_signal);
+        free(output_signal);
+        return;
+    }
+    for (int i = 0; i < signal_length; ++i) {
+        input_signal[i] = (float) ((i * 104729) % 1000) / 1000.0f - 0.5f;
+    }
+    // The tile length is tuned once, outside of the timed runs
+    fir_tiled_tune_tile_length();
+
+    EngineCost measured[PLANNER_GRID_SIZE][PLANNER_ENGINE_COUNT];
+    memset(measured, 0, sizeof(measured));
+    for (int g = 0; g < PLANNER_GRID_SIZE; ++g) {
+        // A typical linear-phase low-pass filter, so that the vectorized engine is timed with its folded kernel
+        FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, planner_grid[g], 8000.0f);
+        if (filter == NULL) {
+            continue;
+        }
+        for (int e = 0; e < PLANNER_ENGINE_COUNT; ++e) {
+            if (e == FIR_ENGINE_DIRECT && planner_grid[g] > PLANNER_CALIBRATION_MAX_DIRECT_LENGTH) {
+                continue;
+            }
+            // Only the transform engines have a plan, whose creation does not depend on the signal length
+            double setup_seconds = 0.0;
+            if (e == FIR_ENGINE_FFT || e == FIR_ENGINE_PARTITIONED) {
+                setup_seconds = time_engine_setup((FIREngine) e, filter);
+            }
+            double seconds = time_engine((FIREngine) e, filter, input_signal, output_signal, signal_length);
+            measured[g][e].setup_seconds = setup_seconds;
+            measured[g][e].sample_seconds = MAX(seconds - setup_seconds, 1e-9) / signal_length;
+        }
+        destroy_fir_filter(filter);
+    }
+
+    pthread_mutex_lock(&wisdom_mutex);
+    memcpy(wisdom, measured, sizeof(wisdom));
+    has_wisdom = 1;
+    pthread_mutex_unlock(&wisdom_mutex);
+
+    free(input_signal);
+    free(output_signal);
+}
+
+int fir_planner_has_wisdom(void) {
+    pthread_mutex_lock(&wisdom_mutex);
+    int result = has_wisdom;
+    pthread_mutex_unlock(&wisdom_mutex);
+    return result;
+}
+
+void fir_planner_forget_wisdom(void) {
+    pthread_mutex_lock(&wisdom_mutex);
+    memset(wisdom, 0, sizeof(wisdom));
+    has_wisdom = 0;
+    pthread_mutex_unlock(&wisdom_mutex);
+}
+
+// The wisdom file starts with the instruction set level it was measured with,
+// followed by one line per measured engine and kernel length
+int fir_planner_save_wisdom(const char *filename) {
+    if (filename == NULL) {
+        fprintf(stderr, "fir_planner_save_wisdom: Invalid input parameter(s).\n");
+        return -1;
+    }
+
+    pthread_mutex_lock(&wisdom_mutex);
+    if (!has_wisdom) {
+        pthread_mutex_unlock(&wisdom_mutex);
+        fprintf(stderr, "No planner wisdom to save, please calibrate first\n");
+        return -1;
+    }
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        pthread_mutex_unlock(&wisdom_mutex);
+        fprintf(stderr, "Failed to open wisdom file: %s\n", filename);
+        return -1;
+    }
+
+    fprintf(file, "# fir_filter wisdom: kernel_length engine setup_seconds sample_seconds\n");
+    fprintf(file, "level %s\n", fir_simd_level_name(fir_simd_detect()));
+    for (int g = 0; g < PLANNER_GRID_SIZE; ++g) {
+        for (int e = 0; e < PLANNER_ENGINE_COUNT; ++e) {
+            if (wisdom[g][e].sample_seconds > 0.0) {
+                fprintf(file, "%d %s %.9g %.9g\n", planner_grid[g], engine_names[e], wisdom[g][e].setup_seconds,
+                        wisdom[g][e].sample_seconds);
+            }
+        }
+    }
+    pthread_mutex_unlock(&wisdom_mutex);
+
+    int failed = ferror(file);
+    if (fclose(file) != 0 || failed) {
+        fprintf(stderr, "Failed to write wisdom file: %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+int fir_planner_load_wisdom(const char *filename) {
+    if (filename == NULL) {
+        fprintf(stderr, "fir_planner_load_wisdom: Invalid input parameter(s).\n");
+        return -1;
+    }
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        return -1;
+    }
+
+    EngineCost loaded[PLANNER_GRID_SIZE][PLANNER_ENGINE_COUNT];
+    memset(loaded, 0, sizeof(loaded));
+    int has_level = 0;
+    int entry_count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char name[32];
+        int kernel_length;
+        double setup_seconds, sample_seconds;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') {
+            continue;
+        }
+        if (!has_level) {
+            // Timings of another instruction set level do not describe this machine
+            if (sscanf(line, "level %31s", name) != 1 || strcmp(name, fir_simd_level_name(fir_simd_detect())) != 0) {
+                fprintf(stderr, "Wisdom file %s was not calibrated for this CPU\n", filename);
+                fclose(file);
+                return -1;
+            }
+            has_level = 1;
+            continue;
+        }
+
+        int g = 0, e = 0;
+        int valid = sscanf(line, "%d %31s %lf %lf", &kernel_length, name, &setup_seconds, &sample_seconds) == 4 &&
+                    setup_seconds >= 0.0 && sample_seconds > 0.0;
+        while (valid && g < PLANNER_GRID_SIZE && planner_grid[g] != kernel_length) ++g;
+        while (valid && e < PLANNER_ENGINE_COUNT && strcmp(engine_names[e], name) != 0) ++e;
+        if (!valid || g == PLANNER_GRID_SIZE || e == PLANNER_ENGINE_COUNT) {
+            fprintf(stderr, "Invalid line in wisdom file: %s", line);
+            fclose(file);
+            return -1;
+        }
+        loaded[g][e].setup_seconds = setup_seconds;
+        loaded[g][e].sample_seconds = sample_seconds;
+        ++entry_count;
+    }
+    fclose(file);
+
+    if (entry_count == 0) {
+        fprintf(stderr, "Wisdom file %s has no entries\n", filename);
+        return -1;
+    }
+    pthread_mutex_lock(&wisdom_mutex);
+    memcpy(wisdom, loaded, sizeof(wisdom));
+    has_wisdom = 1;
+    pthread_mutex_unlock(&wisdom_mutex);
+    return 0;
+}
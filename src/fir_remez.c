@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fir_remez.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Number of dense grid points per coefficient of the amplitude response
+#define REMEZ_GRID_DENSITY 16
+#define REMEZ_MAX_ITERATIONS 100
+// Relative gap between the largest error on the grid and the levelled error at which the exchange has converged
+#define REMEZ_CONVERGENCE 1e-6
+// Largest accepted relative gap between the largest error and the levelled error (0.09 dB), when the exchange
+// stops early because the extrema no longer move
+#define REMEZ_MAX_LEVELLING_GAP 1e-2
+
+// The amplitude response of a symmetric filter with kernel_length = 2M + 1 taps is a cosine polynomial
+// A(w) = sum_{k=0..M} a_k cos(kw), i.e. a polynomial of degree M in x = cos(w). The exchange keeps M + 2 extremal
+// grid points on which the weighted error W(w)(D(w) - A(w)) alternates with the same magnitude delta,
+// and moves them to the extrema of the error of the current solution until the error is levelled.
+
+// Barycentric weights 1 / prod_{j != k} (x_k - x_j) of the given nodes. The products of count - 1 distances
+// under- or overflow for long filters, so they are formed as logarithms and the weights are scaled by the largest
+// one, which cancels in every quotient the weights are used in.
+static void barycentric_weights(const double *nodes, int count, double *weights) {
+    double largest_log_weight = -HUGE_VAL;
+    for (int k = 0; k < count; ++k) {
+        double log_weight = 0.0;
+        for (int j = 0; j < count; ++j) {
+            if (j != k) {
+                log_weight -= log(fabs(nodes[k] - nodes[j]));
+            }
+        }
+        weights[k] = log_weight;
+        largest_log_weight = fmax(largest_log_weight, log_weight);
+    }
+    for (int k = 0; k < count; ++k) {
+        int negative = 0;
+        for (int j = 0; j < count; ++j) {
+            negative ^= j != k && nodes[k] < nodes[j];
+        }
+        double magnitude = exp(weights[k] - largest_log_weight);
+        weights[k] = negative ? -magnitude : magnitude;
+    }
+}
+
+// Lagrange interpolation of the values at the nodes in barycentric form
+static double barycentric_interpolate(double x, const double *nodes, const double *weights, const double *values,
+                                      int count) {
+    double numerator = 0.0;
+    double denominator = 0.0;
+    for (int k = 0; k < count; ++k) {
+        double difference = x - nodes[k];
+        if (difference == 0.0) {
+            return values[k];
+        }
+        double term = weights[k] / difference;
+        numerator += term * values[k];
+        denominator += term;
+    }
+    return numerator / denominator;
+}
+
+// Find the extrema of the error on the grid for the next exchange. Every band edge is a candidate, the
+// neighbours of the same sign are merged into the larger one, and the surplus is removed from the ends or
+// as the smallest pair of neighbours, so that the signs keep alternating. Returns the number of extrema found,
+// which is at most extremal_count.
+static int find_extrema(const double *error, int grid_length, int band_start, int *candidates, int extremal_count) {
+    int count = 0;
+    for (int i = 0; i < grid_length; ++i) {
+        int has_left = i > 0 && i != band_start;
+        int has_right = i < grid_length - 1 && i + 1 != band_start;
+        // The comparison is signed, so that a one-point lobe next to a larger lobe of the other sign is found
+        double sign = error[i] > 0 ? 1.0 : -1.0;
+        double magnitude = fabs(error[i]);
+        if ((!has_left || magnitude >= sign * error[i - 1]) && (!has_right || magnitude > sign * error[i + 1])) {
+            // Keep only the larger of two neighbouring extrema with the same sign
+            if (count > 0 && (error[i] > 0) == (error[candidates[count - 1]] > 0)) {
+                if (magnitude > fabs(error[candidates[count - 1]])) {
+                    candidates[count - 1] = i;
+                }
+            } else {
+                candidates[count++] = i;
+            }
+        }
+    }
+
+    while (count > extremal_count) {
+        // Smallest extremum which is not at one of the ends
+        int smallest = 1;
+        for (int k = 2; k < count - 1; ++k) {
+            if (fabs(error[candidates[k]]) < fabs(error[candidates[smallest]])) {
+                smallest = k;
+            }
+        }
+        int first_is_smaller = fabs(error[candidates[0]]) <= fabs(error[candidates[count - 1]]);
+        double end_magnitude = first_is_smaller ? fabs(error[candidates[0]]) : fabs(error[candidates[count - 1]]);
+        if (count - extremal_count == 1 || count < 4 || end_magnitude <= fabs(error[candidates[smallest]])) {
+            // Removing an end keeps the alternation
+            int removed = first_is_smaller ? 0 : count - 1;
+            for (int k = removed; k < count - 1; ++k) {
+                candidates[k] = candidates[k + 1];
+            }
+            count -= 1;
+        } else {
+            // Removing an inner extremum leaves two neighbours of the same sign, the smaller one goes with it
+            int removed = fabs(error[candidates[smallest - 1]]) < fabs(error[candidates[smallest + 1]]) ?
+                          smallest - 1 : smallest;
+            for (int k = removed; k < count - 2; ++k) {
+                candidates[k] = candidates[k + 2];
+            }
+            count -= 2;
+        }
+    }
+    return count;
+}
+
+// API endpoint to create an equiripple filter
+FIRFilter *create_fir_filter_remez(
+        FilterType type,
+        float passband_edge,
+        float stopband_edge,
+        float passband_weight,
+        float stopband_weight,
+        int kernel_length,
+        float sample_rate
+) {
+    // Validate the input parameters
+    int edges_ordered = type == LOW_PASS ? passband_edge < stopband_edge : stopband_edge < passband_edge;
+    if ((type != LOW_PASS && type != HIGH_PASS) || !edges_ordered || passband_edge <= 0 || stopband_edge <= 0 ||
+        2 * passband_edge >= sample_rate || 2 * stopband_edge >= sample_rate || passband_weight <= 0 ||
+        stopband_weight <= 0 || kernel_length < 3) {
+        fprintf(stderr, "create_fir_filter_remez: Invalid input parameter(s).\n");
+        return NULL;
+    }
+    // Ensure that the kernel length is odd, like create_fir_filter (a symmetric filter of odd length
+    // can have any response at both zero and the Nyquist frequency)
+    if ((kernel_length & 1) == 0) {
+        kernel_length += 1;
+    }
+    int half_M = (kernel_length - 1) / 2;
+    int extremal_count = half_M + 2;
+
+    // Normalized band edges in cycles per sample, [0, lower_edge] and [upper_edge, 0.5]
+    double lower_edge = (double) (type == LOW_PASS ? passband_edge : stopband_edge) / sample_rate;
+    double upper_edge = (double) (type == LOW_PASS ? stopband_edge : passband_edge) / sample_rate;
+    double grid_spacing = 0.5 / (REMEZ_GRID_DENSITY * (half_M + 1));
+    int lower_length = (int) ceil(lower_edge / grid_spacing) + 1;
+    int upper_length = (int) ceil((0.5 - upper_edge) / grid_spacing) + 1;
+    int grid_length = lower_length + upper_length;
+    if (grid_length < extremal_count + 1) {
+        lower_length = upper_length = extremal_count;
+        grid_length = 2 * extremal_count;
+    }
+
+    FIRFilter *filter = NULL;
+    double *grid = (double *) malloc(grid_length * sizeof(double));
+    double *desired = (double *) malloc(grid_length * sizeof(double));
+    double *weight = (double *) malloc(grid_length * sizeof(double));
+    double *error = (double *) malloc(grid_length * sizeof(double));
+    int *extremals = (int *) malloc(grid_length * sizeof(int));
+    int *candidates = (int *) malloc(grid_length * sizeof(int));
+    double *nodes = (double *) malloc(extremal_count * sizeof(double));
+    double *weights = (double *) malloc(extremal_count * sizeof(double));
+    double *values = (double *) malloc(extremal_count * sizeof(double));
+    double *amplitudes = (double *) malloc((half_M + 1) * sizeof(double));
+    if (grid == NULL || desired == NULL || weight == NULL || error == NULL || extremals == NULL ||
+        candidates == NULL || nodes == NULL || weights == NULL || values == NULL || amplitudes == NULL) {
+        fprintf(stderr, "create_fir_filter_remez: Memory allocation for the Remez exchange failed.\n");
+        goto cleanup;
+    }
+
+    // Dense grid in x = cos(2 pi f), with the desired response and the weight of the band of every point
+    for (int i = 0; i < grid_length; ++i) {
+        int in_lower_band = i < lower_length;
+        double frequency = in_lower_band ?
+                           lower_edge * i / (lower_length - 1) :
+                           upper_edge + (0.5 - upper_edge) * (i - lower_length) / (upper_length - 1);
+        int in_passband = in_lower_band == (type == LOW_PASS);
+        grid[i] = cos(2.0 * M_PI * frequency);
+        desired[i] = in_passband ? 1.0 : 0.0;
+        weight[i] = in_passband ? (double) passband_weight : (double) stopband_weight;
+    }
+
+    // Start with extremal points spread evenly over the grid
+    for (int k = 0; k < extremal_count; ++k) {
+        extremals[k] = (int) ((long long) k * (grid_length - 1) / (extremal_count - 1));
+    }
+
+    double delta = 0.0;
+    double max_error = HUGE_VAL;
+    for (int iteration = 0; iteration < REMEZ_MAX_ITERATIONS; ++iteration) {
+        // Levelled error delta of the polynomial which alternates on all M + 2 extremal points
+        for (int k = 0; k < extremal_count; ++k) {
+            nodes[k] = grid[extremals[k]];
+        }
+        barycentric_weights(nodes, extremal_count, weights);
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (int k = 0; k < extremal_count; ++k) {
+            double sign = (k & 1) ? -1.0 : 1.0;
+            numerator += weights[k] * desired[extremals[k]];
+            denominator += weights[k] * sign / weight[extremals[k]];
+        }
+        delta = numerator / denominator;
+
+        // The polynomial of degree M is interpolated from its values on M + 1 of the extremal points. The point
+        // left out is an inner one, since evaluating a polynomial of high degree outside of its nodes (at the
+        // extremal point at the end) amplifies the rounding errors.
+        int skipped = extremal_count / 2;
+        for (int k = 0, j = 0; k < extremal_count; ++k) {
+            if (k != skipped) {
+                double sign = (k & 1) ? -1.0 : 1.0;
+                nodes[j] = nodes[k];
+                values[j++] = desired[extremals[k]] - sign * delta / weight[extremals[k]];
+            }
+        }
+        barycentric_weights(nodes, extremal_count - 1, weights);
+
+        max_error = 0.0;
+        for (int i = 0; i < grid_length; ++i) {
+            double amplitude = barycentric_interpolate(grid[i], nodes, weights, values, extremal_count - 1);
+            error[i] = weight[i] * (desired[i] - amplitude);
+            max_error = fmax(max_error, fabs(error[i]));
+        }
+        if (max_error - fabs(delta) <= REMEZ_CONVERGENCE * max_error) {
+            break;
+        }
+
+        // Exchange the extremal points, unless the error no longer alternates often enough
+        // or the extrema stay where they are (the error is levelled up to the rounding of long filters)
+        if (find_extrema(error, grid_length, lower_length, candidates, extremal_count) < extremal_count) {
+            break;
+        }
+        int changed = 0;
+        for (int k = 0; k < extremal_count; ++k) {
+            changed |= extremals[k] != candidates[k];
+            extremals[k] = candidates[k];
+        }
+        if (!changed) {
+            break;
+        }
+    }
+    // The exchange breaks down when the optimal ripples are below the double rounding error
+    if (!(max_error - fabs(delta) <= REMEZ_MAX_LEVELLING_GAP * max_error)) {
+        fprintf(stderr, "create_fir_filter_remez: The Remez exchange did not converge (largest error %g, levelled "
+                        "error %g), the ripples for this kernel length are below the numerical precision.\n",
+                max_error, fabs(delta));
+        goto cleanup;
+    }
+
+    filter = (FIRFilter *) malloc(sizeof(FIRFilter));
+    if (filter == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRFilter\n");
+        goto cleanup;
+    }
+    filter->type = type;
+    filter->window = REMEZ;
+    filter->cutoff_freq = (passband_edge + stopband_edge) / 2.0f;
+    filter->kernel_length = kernel_length;
+    filter->sample_rate = sample_rate;
+    filter->kaiser_beta = 0.0f;
+    filter->cutoff_freq_high = 0.0f;
+    filter->coefficients = (float *) malloc(kernel_length * sizeof(float));
+    if (filter->coefficients == NULL) {
+        fprintf(stderr, "Failed to allocate memory for coefficients of the filter\n");
+        free(filter);
+        filter = NULL;
+        goto cleanup;
+    }
+
+    // The impulse response is the inverse DFT of the amplitude response sampled at w_l = 2 pi l / kernel_length,
+    // which is exact since A(w) has no harmonics above M:
+    // h[M + m] = h[M - m] = (A(0) + 2 sum_{l=1..M} A(w_l) cos(w_l m)) / kernel_length
+    for (int l = 0; l <= half_M; ++l) {
+        double x = cos(2.0 * M_PI * l / kernel_length);
+        amplitudes[l] = barycentric_interpolate(x, nodes, weights, values, extremal_count - 1);
+    }
+    for (int m = 0; m <= half_M; ++m) {
+        double sum = amplitudes[0];
+        for (int l = 1; l <= half_M; ++l) {
+            sum += 2.0 * amplitudes[l] * cos(2.0 * M_PI * (double) ((long long) l * m % kernel_length) / kernel_length);
+        }
+        float coefficient = (float) (sum / kernel_length);
+        filter->coefficients[half_M + m] = coefficient;
+        filter->coefficients[half_M - m] = coefficient;
+    }
+    detect_fir_filter_structure(filter);
+
+cleanup:
+    free(grid);
+    free(desired);
+    free(weight);
+    free(error);
+    free(extremals);
+    free(candidates);
+    free(nodes);
+    free(weights);
+    free(values);
+    free(amplitudes);
+    return filter;
+}
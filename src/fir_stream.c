@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fir_stream.h"
+
+struct FIRStream {
+    float *coefficients;        // Copy of the filter coefficients
+    int kernel_length;          // Number of taps
+    float *delay_line;          // Last kernel_length input samples, stored twice
+    int position;               // Index of the newest sample in the first copy of the delay line
+    int history_length;         // Number of samples seen since the start of the stream, up to kernel_length - 1
+};
+
+FIRStream *create_fir_stream(const FIRFilter *filter) {
+    // Validate the input parameters
+    if (filter == NULL || filter->coefficients == NULL || filter->kernel_length <= 0) {
+        fprintf(stderr, "create_fir_stream: Invalid input parameter(s).\n");
+        return NULL;
+    }
+
+    FIRStream *stream = (FIRStream *) malloc(sizeof(FIRStream));
+    if (stream == NULL) {
+        fprintf(stderr, "Failed to allocate memory for FIRStream\n");
+        return NULL;
+    }
+
+    stream->kernel_length = filter->kernel_length;
+    stream->coefficients = (float *) malloc(filter->kernel_length * sizeof(float));
+    stream->delay_line = (float *) calloc(2 * filter->kernel_length, sizeof(float));
+    if (stream->coefficients == NULL || stream->delay_line == NULL) {
+        fprintf(stderr, "Failed to allocate memory for the FIRStream buffers\n");
+        destroy_fir_stream(stream);
+        return NULL;
+    }
+    memcpy(stream->coefficients, filter->coefficients, filter->kernel_length * sizeof(float));
+    stream->position = 0;
+    stream->history_length = 0;
+    return stream;
+}
+
+// API endpoint for filtering the next samples of a stream
+void process_fir_stream(
+        FIRStream *stream,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length
+) {
+    // Check for valid input parameters
+    if (stream == NULL || input_signal == NULL || output_signal == NULL || signal_length < 0) {
+        fprintf(stderr, "process_fir_stream: Invalid input parameter(s).\n");
+        return;
+    }
+
+    int kernel_length = stream->kernel_length;
+    const float *coefficients = stream->coefficients;
+    float *delay_line = stream->delay_line;
+
+    for (int i = 0; i < signal_length; ++i) {
+        // The delay line runs backwards, so the window starting at the newest sample holds
+        // x[n], x[n-1], ..., x[n-kernel_length+1] in order. Every sample is written to both copies,
+        // which keeps that window contiguous for every position.
+        stream->position = stream->position == 0 ? kernel_length - 1 : stream->position - 1;
+        delay_line[stream->position] = input_signal[i];
+        delay_line[stream->position + kernel_length] = input_signal[i];
+        const float *window = delay_line + stream->position;
+
+        // Until kernel_length - 1 samples have been seen only the taps over the seen samples are summed,
+        // which keeps the summation identical to the one of apply_fir_filter
+        int taps = kernel_length;
+        if (stream->history_length < kernel_length - 1) {
+            taps = ++stream->history_length;
+        }
+
+        float sum = 0;
+        for (int j = 0; j < taps; ++j) {
+            sum += coefficients[j] * window[j];
+        }
+        output_signal[i] = sum;
+    }
+}
+
+void reset_fir_stream(FIRStream *stream) {
+    if (stream != NULL) {
+        memset(stream->delay_line, 0, 2 * stream->kernel_length * sizeof(float));
+        stream->position = 0;
+        stream->history_length = 0;
+    }
+}
+
+// API endpoint to free the memory held by the stream
+void destroy_fir_stream(FIRStream *stream) {
+    if (stream != NULL) {
+        free(stream->coefficients);
+        free(stream->delay_line);
+        free(stream);
+    }
+}
@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "fir_tiled.h"
+#include "fir_filter_internal.h"
+
+// Candidate tile lengths of the calibration, and the synthetic problem they are timed on
+#define TILED_MIN_TILE_LENGTH 128
+#define TILED_MAX_TILE_LENGTH 4096
+#define TILED_CALIBRATION_KERNEL_LENGTH 8192
+#define TILED_CALIBRATION_SIGNAL_LENGTH 16384
+
+// Every tile kernel adds the taps [tap_begin, tap_end) to the partial sums in output[begin, end), for which
+// all of these taps overlap the signal (begin >= tap_end - 1). The taps are added one by one in increasing order,
+// with a separate multiplication and addition, which is exactly the arithmetic of apply_fir_filter.
+// Several outputs are computed at once in vector lanes, each lane holding the partial sum of its own output.
+typedef void (*TileKernel)(const float *coefficients, int tap_begin, int tap_end, const float *input, float *output,
+                           int begin, int end);
+
+static void tile_kernel_scalar(const float *coefficients, int tap_begin, int tap_end, const float *input,
+                               float *output, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float sum = output[i];
+        for (int j = tap_begin; j < tap_end; ++j) {
+            sum += coefficients[j] * input[i - j];
+        }
+        output[i] = sum;
+    }
+}
+
+#if FIR_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void tile_kernel_sse41(const float *coefficients, int tap_begin, int tap_end, const float *input,
+                              float *output, int begin, int end) {
+    int i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m128 acc0 = _mm_loadu_ps(output + i), acc1 = _mm_loadu_ps(output + i + 4);
+        __m128 acc2 = _mm_loadu_ps(output + i + 8), acc3 = _mm_loadu_ps(output + i + 12);
+        for (int j = tap_begin; j < tap_end; ++j) {
+            const float *x = input + i - j;
+            __m128 h = _mm_set1_ps(coefficients[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + 12)));
+        }
+        _mm_storeu_ps(output + i, acc0);
+        _mm_storeu_ps(output + i + 4, acc1);
+        _mm_storeu_ps(output + i + 8, acc2);
+        _mm_storeu_ps(output + i + 12, acc3);
+    }
+    tile_kernel_scalar(coefficients, tap_begin, tap_end, input, output, i, end);
+}
+
+__attribute__((target("avx2")))
+static void tile_kernel_avx2(const float *coefficients, int tap_begin, int tap_end, const float *input,
+                             float *output, int begin, int end) {
+    int i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m256 acc0 = _mm256_loadu_ps(output + i), acc1 = _mm256_loadu_ps(output + i + 8);
+        __m256 acc2 = _mm256_loadu_ps(output + i + 16), acc3 = _mm256_loadu_ps(output + i + 24);
+        for (int j = tap_begin; j < tap_end; ++j) {
+            const float *x = input + i - j;
+            __m256 h = _mm256_set1_ps(coefficients[j]);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(h, _mm256_loadu_ps(x)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(h, _mm256_loadu_ps(x + 8)));
+            acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(h, _mm256_loadu_ps(x + 16)));
+            acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(h, _mm256_loadu_ps(x + 24)));
+        }
+        _mm256_storeu_ps(output + i, acc0);
+        _mm256_storeu_ps(output + i + 8, acc1);
+        _mm256_storeu_ps(output + i + 16, acc2);
+        _mm256_storeu_ps(output + i + 24, acc3);
+    }
+    tile_kernel_sse41(coefficients, tap_begin, tap_end, input, output, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void tile_kernel_avx512(const float *coefficients, int tap_begin, int tap_end, const float *input,
+                               float *output, int begin, int end) {
+    int i = begin;
+    for (; i + 64 <= end; i += 64) {
+        __m512 acc0 = _mm512_loadu_ps(output + i), acc1 = _mm512_loadu_ps(output + i + 16);
+        __m512 acc2 = _mm512_loadu_ps(output + i + 32), acc3 = _mm512_loadu_ps(output + i + 48);
+        for (int j = tap_begin; j < tap_end; ++j) {
+            const float *x = input + i - j;
+            __m512 h = _mm512_set1_ps(coefficients[j]);
+            acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(h, _mm512_loadu_ps(x)));
+            acc1 = _mm512_add_ps(acc1, _mm512_mul_ps(h, _mm512_loadu_ps(x + 16)));
+            acc2 = _mm512_add_ps(acc2, _mm512_mul_ps(h, _mm512_loadu_ps(x + 32)));
+            acc3 = _mm512_add_ps(acc3, _mm512_mul_ps(h, _mm512_loadu_ps(x + 48)));
+        }
+        _mm512_storeu_ps(output + i, acc0);
+        _mm512_storeu_ps(output + i + 16, acc1);
+        _mm512_storeu_ps(output + i + 32, acc2);
+        _mm512_storeu_ps(output + i + 48, acc3);
+    }
+    tile_kernel_avx2(coefficients, tap_begin, tap_end, input, output, i, end);
+}
+
+#endif // FIR_SIMD_X86
+
+// Select the tile kernel for the best instruction set level of the running CPU
+static TileKernel select_tile_kernel(void) {
+#if FIR_SIMD_X86
+    switch (fir_simd_detect()) {
+        case FIR_SIMD_AVX512:
+            return tile_kernel_avx512;
+        case FIR_SIMD_AVX2:
+            return tile_kernel_avx2;
+        case FIR_SIMD_SSE41:
+            return tile_kernel_sse41;
+        default:
+            break;
+    }
+#endif
+    return tile_kernel_scalar;
+}
+
+// The tiled convolution, without validation of the parameters
+static void tiled_convolution(const float *coefficients, int kernel_length, const float *input_signal,
+                              float *output_signal, int signal_length, int tile_length) {
+    TileKernel kernel = select_tile_kernel();
+    for (int begin = 0; begin < signal_length; begin += tile_length) {
+        int end = MIN(begin + tile_length, signal_length);
+        memset(output_signal + begin, 0, (end - begin) * sizeof(float));
+
+        for (int tap_begin = 0; tap_begin < kernel_length && tap_begin <= end - 1; tap_begin += tile_length) {
+            int tap_end = MIN(tap_begin + tile_length, kernel_length);
+
+            // Outputs before tap_end - 1 only overlap a part of the tap tile, as the first
+            // kernel_length - 1 outputs of apply_fir_filter, and only get the taps up to their own index
+            int full_begin = MAX(begin, tap_end - 1);
+            for (int i = MAX(begin, tap_begin); i < MIN(full_begin, end); ++i) {
+                float sum = output_signal[i];
+                for (int j = tap_begin; j <= i; ++j) {
+                    sum += coefficients[j] * input_signal[i - j];
+                }
+                output_signal[i] = sum;
+            }
+            if (full_begin < end) {
+                kernel(coefficients, tap_begin, tap_end, input_signal, output_signal, full_begin, end);
+            }
+        }
+    }
+}
+
+// Monotonic wall-clock time in seconds, for the calibrations of the tiled engine and the planner
+double fir_monotonic_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+}
+
+static int tuned_tile_length = 1024;
+static pthread_once_t tune_once = PTHREAD_ONCE_INIT;
+
+// Time every candidate tile length on a kernel which is much larger than the L1 cache, the best of two runs counts
+static void tune_tile_length(void) {
+    float *coefficients = (float *) malloc(TILED_CALIBRATION_KERNEL_LENGTH * sizeof(float));
+    float *input = (float *) malloc(TILED_CALIBRATION_SIGNAL_LENGTH * sizeof(float));
+    float *output = (float *) malloc(TILED_CALIBRATION_SIGNAL_LENGTH * sizeof(float));
+    if (coefficients == NULL || input == NULL || output == NULL) {
+        free(coefficients);
+        free(input);
+        free(output);
+        return;
+    }
+    for (int i = 0; i < TILED_CALIBRATION_KERNEL_LENGTH; ++i) {
+        coefficients[i] = (float) ((i * 7919) % 1000) / 1000.0f - 0.5f;
+    }
+    for (int i = 0; i < TILED_CALIBRATION_SIGNAL_LENGTH; ++i) {
+        input[i] = (float) ((i * 104729) % 1000) / 1000.0f - 0.5f;
+    }
+
+    double best_time = 0.0;
+    for (int tile_length = TILED_MIN_TILE_LENGTH; tile_length <= TILED_MAX_TILE_LENGTH; tile_length *= 2) {
+        for (int run = 0; run < 2; ++run) {
+            double start = fir_monotonic_seconds();
+            tiled_convolution(coefficients, TILED_CALIBRATION_KERNEL_LENGTH, input, output,
+                              TILED_CALIBRATION_SIGNAL_LENGTH, tile_length);
+            double time = fir_monotonic_seconds() - start;
+            if (best_time == 0.0 || time < best_time) {
+                best_time = time;
+                tuned_tile_length = tile_length;
+            }
+        }
+    }
+
+    free(coefficients);
+    free(input);
+    free(output);
+}
+
+int fir_tiled_tune_tile_length(void) {
+    pthread_once(&tune_once, tune_tile_length);
+    return tuned_tile_length;
+}
+
+// API endpoint for applying the filter with the tiled direct convolution
+void apply_fir_filter_tiled(
+        FIRFilter *filter,
+        const float *input_signal,
+        float *output_signal,
+        int signal_length,
+        int tile_length
+) {
+    // Check for valid input parameters
+    if (filter == NULL || filter->coefficients == NULL || input_signal == NULL || output_signal == NULL ||
+        signal_length < 0 || tile_length < 0) {
+        fprintf(stderr, "apply_fir_filter_tiled: Invalid input parameter(s).\n");
+        return;
+    }
+
+    if (tile_length == 0) {
+        tile_length = fir_tiled_tune_tile_length();
+    }
+    tiled_convolution(filter->coefficients, filter->kernel_length, input_signal, output_signal, signal_length,
+                      tile_length);
+}
@@ -14,8 +14,20 @@ int main(int argc, char *argv[]) {
 
     if (strcmp(argv[1], "create") == 0) {
         handle_create_fir_filter(argc, argv);
+    } else if (strcmp(argv[1], "create_kaiser") == 0) {
+        handle_create_kaiser_fir_filter(argc, argv);
     } else if (strcmp(argv[1], "apply") == 0) {
         handle_apply_fir_filter(argc, argv);
+    } else if (strcmp(argv[1], "decimate") == 0) {
+        handle_decimate_fir_filter(argc, argv);
+    } else if (strcmp(argv[1], "interpolate") == 0) {
+        handle_interpolate_fir_filter(argc, argv);
+    } else if (strcmp(argv[1], "resample") == 0) {
+        handle_resample_signal(argc, argv);
+    } else if (strcmp(argv[1], "apply_q15") == 0) {
+        handle_apply_q15_fir_filter(argc, argv);
+    } else if (strcmp(argv[1], "calibrate") == 0) {
+        handle_calibrate_planner(argc, argv);
     } else if (strcmp(argv[1], "destroy") == 0) {
         handle_destroy_fir_filter(argc, argv);
     } else {
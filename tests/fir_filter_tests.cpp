@@ -1,9 +1,29 @@
 #include <limits>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
 #include <iostream>
 #include "gtest/gtest.h"
 
 extern "C" {
 #include "fir_filter.h"
+#include "fir_filter_fft.h"
+#include "fir_filter_simd.h"
+#include "fir_partitioned.h"
+#include "fir_multirate.h"
+#include "fir_stream.h"
+#include "fir_multichannel.h"
+#include "fir_filter_bank.h"
+#include "fir_parallel.h"
+#include "fir_tiled.h"
+#include "fir_planner.h"
+#include "fir_fixed_point.h"
+#include "fir_half_precision.h"
+#include "fir_filter_double.h"
+#include "fir_complex.h"
+#include "fir_remez.h"
+#include "fir_min_phase.h"
 }
 
 // Helper function to print filter coefficients
@@ -21,6 +41,23 @@ void compare_arrays(const float *arr1, const float *arr2, int length, float tole
     }
 }
 
+// Helper function to fill a signal with reproducible pseudo-random values in [-1, 1]
+void fill_random_signal(float *signal, int length, unsigned int seed = 1) {
+    srand(seed);
+    for (int i = 0; i < length; ++i) {
+        signal[i] = 2.0f * (float) rand() / (float) RAND_MAX - 1.0f;
+    }
+}
+
+// Helper function to calculate the magnitude response |H(f)| of a filter at the frequency freq in Hz
+double magnitude_response(const FIRFilter *filter, double freq) {
+    std::complex<double> response = 0.0;
+    for (int n = 0; n < filter->kernel_length; ++n) {
+        response += (double) filter->coefficients[n] * std::polar(1.0, -2.0 * M_PI * freq * n / filter->sample_rate);
+    }
+    return std::abs(response);
+}
+
 
 // =================================
 // = UNIT TESTS: create_fir_filter =
@@ -207,6 +244,427 @@ TEST(FIRFilterCreateTest, EdgeCases) {
     }
 }
 
+// Long Kaiser designs (large Bessel function arguments near the center) match the double precision design
+TEST(FIRFilterCreateTest, LongKaiserMatchesDoubleDesign) {
+    WindowType windows[] = {KAISER_B6, KAISER_B8, KAISER_B10};
+    for (WindowType window : windows) {
+        const int kernel_length = 65535;
+        auto start = std::chrono::steady_clock::now();
+        FIRFilter *filter = create_fir_filter(LOW_PASS, window, 1000.0f, kernel_length, 48000.0f);
+        auto end = std::chrono::steady_clock::now();
+        FIRFilterDouble *filter_double = create_fir_filter_double(LOW_PASS, window, 1000.0, kernel_length, 48000.0);
+        ASSERT_NE(filter, nullptr);
+        ASSERT_NE(filter_double, nullptr);
+        std::cout << "Kaiser design with " << kernel_length << " taps: "
+                  << std::chrono::duration<double>(end - start).count() * 1000.0 << " ms" << std::endl;
+
+        for (int i = 0; i < kernel_length; ++i) {
+            ASSERT_NEAR(filter->coefficients[i], filter_double->coefficients[i], 1e-6) << "at index " << i;
+        }
+        destroy_fir_filter(filter);
+        destroy_fir_filter_double(filter_double);
+    }
+}
+
+TEST(FIRFilterCreateTest, KaiserFormulas) {
+    ASSERT_NEAR(fir_kaiser_beta(60.0f), 0.1102f * (60.0f - 8.7f), 1e-5);
+    ASSERT_NEAR(fir_kaiser_beta(40.0f), 0.5842f * std::pow(19.0f, 0.4f) + 0.07886f * 19.0f, 1e-5);
+    ASSERT_EQ(fir_kaiser_beta(15.0f), 0.0f);
+
+    // (60 - 8) / (2.285 * 2 * pi * 500 / 48000) = 347.7 -> 349 taps (rounded up, odd)
+    ASSERT_EQ(fir_kaiser_kernel_length(60.0f, 500.0f, 48000.0f), 349);
+    ASSERT_EQ(fir_kaiser_kernel_length(60.0f, 0.0f, 48000.0f), 0);
+
+    // The generic Kaiser window has no beta without a specification
+    ASSERT_EQ(create_fir_filter(LOW_PASS, KAISER, 1000.0f, 11, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_kaiser(LOW_PASS, 1000.0f, 60.0f, -500.0f, 8000.0f), nullptr);
+}
+
+// The designed filter meets the attenuation in the stop band and the matching ripple in the pass band
+TEST(FIRFilterCreateTest, KaiserSpecificationMet) {
+    const float sample_rate = 48000.0f, cutoff_freq = 6000.0f, transition_width = 1000.0f;
+    const float attenuations[] = {40.0f, 60.0f, 90.0f};
+    for (FilterType type : {LOW_PASS, HIGH_PASS}) {
+        for (float attenuation_db : attenuations) {
+            FIRFilter *filter = create_fir_filter_kaiser(type, cutoff_freq, attenuation_db, transition_width,
+                                                         sample_rate);
+            ASSERT_NE(filter, nullptr);
+            ASSERT_EQ(filter->window, KAISER);
+            ASSERT_EQ(filter->kernel_length, fir_kaiser_kernel_length(attenuation_db, transition_width, sample_rate));
+            ASSERT_FLOAT_EQ(filter->kaiser_beta, fir_kaiser_beta(attenuation_db));
+
+            // Largest deviation from the ideal response, in the pass band and the stop band
+            double max_pass_error = 0.0, max_stop_gain = 0.0;
+            for (double freq = 0.0; freq <= sample_rate / 2; freq += 10.0) {
+                std::complex<double> response = 0.0;
+                for (int n = 0; n < filter->kernel_length; ++n) {
+                    response += (double) filter->coefficients[n] * std::polar(1.0, -2.0 * M_PI * freq * n / sample_rate);
+                }
+                int in_low_band = freq <= cutoff_freq - transition_width / 2;
+                int in_high_band = freq >= cutoff_freq + transition_width / 2;
+                if ((type == LOW_PASS && in_low_band) || (type == HIGH_PASS && in_high_band)) {
+                    max_pass_error = std::max(max_pass_error, std::abs(std::abs(response) - 1.0));
+                } else if (in_low_band || in_high_band) {
+                    max_stop_gain = std::max(max_stop_gain, std::abs(response));
+                }
+            }
+            // Kaiser's formulas are empirical, allow half a dB
+            double ripple = std::pow(10.0, -(attenuation_db - 0.5) / 20.0);
+            EXPECT_LE(max_stop_gain, ripple) << "attenuation " << attenuation_db;
+            EXPECT_LE(max_pass_error, ripple) << "attenuation " << attenuation_db;
+            std::cout << "Kaiser " << attenuation_db << " dB: " << filter->kernel_length << " taps, beta "
+                      << filter->kaiser_beta << ", stop band " << 20.0 * std::log10(max_stop_gain) << " dB" << std::endl;
+            destroy_fir_filter(filter);
+        }
+    }
+}
+
+// A band-pass filter is one kernel, the difference of the low-pass filters at its edges
+TEST(FIRFilterCreateTest, BandPassIsDifferenceOfLowPass) {
+    WindowType windows[] = {RECT, HANNING, HAMMING, BLACKMAN, KAISER_B6, KAISER_B8, KAISER_B10};
+    for (WindowType window : windows) {
+        FIRFilter *band_pass = create_fir_filter_band(BAND_PASS, window, 1000.0f, 2000.0f, 101, 8000.0f);
+        FIRFilter *band_stop = create_fir_filter_band(BAND_STOP, window, 1000.0f, 2000.0f, 101, 8000.0f);
+        FIRFilter *low_pass_low = create_fir_filter(LOW_PASS, window, 1000.0f, 101, 8000.0f);
+        FIRFilter *low_pass_high = create_fir_filter(LOW_PASS, window, 2000.0f, 101, 8000.0f);
+        ASSERT_NE(band_pass, nullptr);
+        ASSERT_NE(band_stop, nullptr);
+        ASSERT_EQ(band_pass->cutoff_freq_high, 2000.0f);
+        ASSERT_TRUE(band_pass->is_symmetric);
+        ASSERT_TRUE(band_stop->is_symmetric);
+
+        int half_M = (band_pass->kernel_length - 1) / 2;
+        for (int n = 0; n < band_pass->kernel_length; ++n) {
+            ASSERT_NEAR(band_pass->coefficients[n], low_pass_high->coefficients[n] - low_pass_low->coefficients[n],
+                        1e-6);
+            // Spectral inversion: band-stop = delta - band-pass
+            ASSERT_EQ(band_stop->coefficients[n], (n == half_M ? 1.0f : 0.0f) - band_pass->coefficients[n]);
+        }
+        destroy_fir_filter(band_pass);
+        destroy_fir_filter(band_stop);
+        destroy_fir_filter(low_pass_low);
+        destroy_fir_filter(low_pass_high);
+    }
+}
+
+// One band-pass pass gives the frequency response of the low-pass / high-pass cascade
+TEST(FIRFilterCreateTest, BandFrequencyResponse) {
+    const float sample_rate = 48000.0f, low_edge = 4000.0f, high_edge = 8000.0f;
+    FIRFilter *band_pass = create_fir_filter_band(BAND_PASS, KAISER_B8, low_edge, high_edge, 255, sample_rate);
+    FIRFilter *band_stop = create_fir_filter_band(BAND_STOP, KAISER_B8, low_edge, high_edge, 255, sample_rate);
+    ASSERT_NE(band_pass, nullptr);
+    ASSERT_NE(band_stop, nullptr);
+
+    // Kaiser beta = 8: the transition is about 1.2 kHz wide for 255 taps at 48 kHz
+    for (double freq = 0.0; freq <= sample_rate / 2; freq += 50.0) {
+        int in_band = freq >= low_edge + 800.0 && freq <= high_edge - 800.0;
+        int out_of_band = freq <= low_edge - 800.0 || freq >= high_edge + 800.0;
+        double band_pass_gain = magnitude_response(band_pass, freq);
+        double band_stop_gain = magnitude_response(band_stop, freq);
+        if (in_band) {
+            ASSERT_NEAR(band_pass_gain, 1.0, 1e-3) << "at " << freq << " Hz";
+            ASSERT_LT(band_stop_gain, 1e-3) << "at " << freq << " Hz";
+        } else if (out_of_band) {
+            ASSERT_LT(band_pass_gain, 1e-3) << "at " << freq << " Hz";
+            ASSERT_NEAR(band_stop_gain, 1.0, 1e-3) << "at " << freq << " Hz";
+        }
+    }
+    destroy_fir_filter(band_pass);
+    destroy_fir_filter(band_stop);
+}
+
+TEST(FIRFilterCreateTest, BandInvalidParameters) {
+    ASSERT_EQ(create_fir_filter(BAND_PASS, HAMMING, 1000.0f, 101, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_band(BAND_PASS, HAMMING, 2000.0f, 1000.0f, 101, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_band(BAND_STOP, HAMMING, 0.0f, 1000.0f, 101, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_band(LOW_PASS, HAMMING, 1000.0f, 2000.0f, 101, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_band(BAND_PASS, KAISER, 1000.0f, 2000.0f, 101, 8000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_kaiser(BAND_PASS, 1000.0f, 60.0f, 100.0f, 8000.0f), nullptr);
+}
+
+
+// =======================================
+// = UNIT TESTS: create_fir_filter_remez =
+// =======================================
+
+// Largest pass band error |A(f) - 1| and stop band gain |A(f)| of a symmetric odd-length filter, on a dense grid
+static void measure_band_errors(const FIRFilter *filter, float passband_edge, float stopband_edge,
+                                double &pass_error, double &stop_gain) {
+    int half_M = (filter->kernel_length - 1) / 2;
+    pass_error = 0.0;
+    stop_gain = 0.0;
+    const int point_count = 4000;
+    for (int i = 0; i <= point_count; ++i) {
+        double freq = 0.5 * filter->sample_rate * i / point_count;
+        int in_low_band = freq <= std::min(passband_edge, stopband_edge);
+        int in_high_band = freq >= std::max(passband_edge, stopband_edge);
+        if (!in_low_band && !in_high_band) {
+            continue;
+        }
+        double omega = 2.0 * M_PI * freq / filter->sample_rate;
+        double amplitude = filter->coefficients[half_M];
+        for (int k = 1; k <= half_M; ++k) {
+            amplitude += 2.0 * filter->coefficients[half_M - k] * std::cos(k * omega);
+        }
+        if (in_low_band == (passband_edge < stopband_edge)) {
+            pass_error = std::max(pass_error, std::abs(amplitude - 1.0));
+        } else {
+            stop_gain = std::max(stop_gain, std::abs(amplitude));
+        }
+    }
+}
+
+// The ripples of an equiripple design are in the inverse ratio of the weights
+TEST(FIRFilterRemezTest, RipplesFollowWeights) {
+    const float sample_rate = 48000.0f;
+    struct {
+        FilterType type;
+        float passband_edge, stopband_edge, stopband_weight;
+        int kernel_length;
+    } cases[] = {
+            {LOW_PASS,  5000.0f,  6000.0f,  10.0f, 101},
+            {LOW_PASS,  2000.0f,  3000.0f,  1.0f,  63},
+            {HIGH_PASS, 10000.0f, 8000.0f,  10.0f, 61},
+    };
+    for (const auto &c : cases) {
+        FIRFilter *filter = create_fir_filter_remez(c.type, c.passband_edge, c.stopband_edge, 1.0f, c.stopband_weight,
+                                                    c.kernel_length, sample_rate);
+        ASSERT_NE(filter, nullptr);
+        ASSERT_EQ(filter->window, REMEZ);
+        ASSERT_EQ(filter->kernel_length, c.kernel_length);
+        ASSERT_TRUE(filter->is_symmetric);
+
+        double pass_error, stop_gain;
+        measure_band_errors(filter, c.passband_edge, c.stopband_edge, pass_error, stop_gain);
+        EXPECT_NEAR(pass_error / stop_gain, c.stopband_weight, 0.02 * c.stopband_weight);
+        std::cout << "Remez " << c.kernel_length << " taps: pass band ripple " << pass_error << ", stop band "
+                  << 20.0 * std::log10(stop_gain) << " dB" << std::endl;
+        destroy_fir_filter(filter);
+    }
+}
+
+// The weighted error of the optimal design reaches its maximum with alternating signs on at least M + 2 frequencies
+// (alternation theorem). The sign runs of the error over both bands are counted, where the peak of the run is
+// within 5% of the largest error: the design grid (16 points per coefficient) misses the peaks of the narrow
+// ripples at the band edges by a few percent.
+TEST(FIRFilterRemezTest, RipplesAreLevelled) {
+    const float sample_rate = 48000.0f;
+    struct {
+        FilterType type;
+        float passband_edge, stopband_edge, stopband_weight;
+        int kernel_length;
+    } cases[] = {
+            {LOW_PASS,  5000.0f,  6000.0f,  10.0f, 101},
+            {LOW_PASS,  2000.0f,  3000.0f,  1.0f,  63},
+            {HIGH_PASS, 10000.0f, 8000.0f,  10.0f, 61},
+            {LOW_PASS,  8000.0f,  8400.0f,  1.0f,  301},
+            {HIGH_PASS, 12000.0f, 11000.0f, 3.0f,  101},
+    };
+    for (const auto &c : cases) {
+        FIRFilter *filter = create_fir_filter_remez(c.type, c.passband_edge, c.stopband_edge, 1.0f, c.stopband_weight,
+                                                    c.kernel_length, sample_rate);
+        ASSERT_NE(filter, nullptr);
+        int half_M = (filter->kernel_length - 1) / 2;
+
+        // Dense grid over both bands, including the band edges
+        std::vector<double> error;
+        const double lower_edge = std::min(c.passband_edge, c.stopband_edge);
+        const double upper_edge = std::max(c.passband_edge, c.stopband_edge);
+        const int point_count = 64 * (half_M + 1);
+        for (int i = 0; i <= 2 * point_count + 1; ++i) {
+            int in_low_band = i <= point_count;
+            double freq = in_low_band ? lower_edge * i / point_count :
+                          upper_edge + (0.5 * sample_rate - upper_edge) * (i - point_count - 1) / point_count;
+            double omega = 2.0 * M_PI * freq / sample_rate;
+            double amplitude = filter->coefficients[half_M];
+            for (int k = 1; k <= half_M; ++k) {
+                amplitude += 2.0 * filter->coefficients[half_M - k] * std::cos(k * omega);
+            }
+            int in_passband = in_low_band == (c.type == LOW_PASS);
+            error.push_back(in_passband ? 1.0 - amplitude : -c.stopband_weight * amplitude);
+        }
+        double max_error = 0.0;
+        for (double e : error) {
+            max_error = std::max(max_error, std::abs(e));
+        }
+
+        int levelled_count = 0;
+        for (size_t start = 0, end; start < error.size(); start = end) {
+            double peak = 0.0;
+            for (end = start; end < error.size() && (error[end] > 0) == (error[start] > 0); ++end) {
+                peak = std::max(peak, std::abs(error[end]));
+            }
+            levelled_count += peak >= 0.95 * max_error;
+        }
+        EXPECT_GE(levelled_count, half_M + 2) << c.kernel_length << " taps";
+        destroy_fir_filter(filter);
+    }
+}
+
+TEST(FIRFilterRemezTest, InvalidParameters) {
+    ASSERT_EQ(create_fir_filter_remez(LOW_PASS, 6000.0f, 5000.0f, 1.0f, 1.0f, 101, 48000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_remez(HIGH_PASS, 5000.0f, 6000.0f, 1.0f, 1.0f, 101, 48000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_remez(LOW_PASS, 5000.0f, 24000.0f, 1.0f, 1.0f, 101, 48000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_remez(LOW_PASS, 5000.0f, 6000.0f, 0.0f, 1.0f, 101, 48000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter_remez(LOW_PASS, 5000.0f, 6000.0f, 1.0f, 1.0f, 1, 48000.0f), nullptr);
+    ASSERT_EQ(create_fir_filter(LOW_PASS, REMEZ, 5000.0f, 101, 48000.0f), nullptr);
+}
+
+// Shortest odd kernel length for which the design meets the ripple specification (doubling, then binary search
+// between the last failing and the first passing half length), or 0 if no length up to 2049 taps meets it
+template<typename Design>
+static int shortest_kernel_length(Design design, float passband_edge, float stopband_edge, double pass_ripple,
+                                  double stop_ripple) {
+    auto meets = [&](int kernel_length) {
+        FIRFilter *filter = design(kernel_length);
+        if (filter == nullptr) {
+            return false;
+        }
+        double pass_error, stop_gain;
+        measure_band_errors(filter, passband_edge, stopband_edge, pass_error, stop_gain);
+        destroy_fir_filter(filter);
+        return pass_error <= pass_ripple && stop_gain <= stop_ripple;
+    };
+    int low = 1, high = 1;
+    while (!meets(2 * high + 1)) {
+        if (high >= 1024) {
+            return 0;
+        }
+        low = high + 1;
+        high *= 2;
+    }
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (meets(2 * middle + 1)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return 2 * low + 1;
+}
+
+// Benchmark: taps needed by every design method for 0.1 dB pass band ripple and 60 dB stop band attenuation
+TEST(FIRFilterRemezTest, TapCountAgainstWindows) {
+    const float sample_rate = 48000.0f, passband_edge = 5000.0f, stopband_edge = 6000.0f;
+    const float cutoff_freq = (passband_edge + stopband_edge) / 2.0f;
+    const double pass_ripple = std::pow(10.0, 0.1 / 20.0) - 1.0, stop_ripple = 1e-3;
+
+    const char *window_names[] = {"rect", "hanning", "hamming", "blackman", "kaiser_b6", "kaiser_b8", "kaiser_b10"};
+    WindowType windows[] = {RECT, HANNING, HAMMING, BLACKMAN, KAISER_B6, KAISER_B8, KAISER_B10};
+    int shortest_window_length = 0;
+    for (int w = 0; w < 7; ++w) {
+        int kernel_length = shortest_kernel_length([&](int length) {
+            return create_fir_filter(LOW_PASS, windows[w], cutoff_freq, length, sample_rate);
+        }, passband_edge, stopband_edge, pass_ripple, stop_ripple);
+        std::cout << window_names[w] << ": " << (kernel_length ? std::to_string(kernel_length) : "not reached")
+                  << " taps" << std::endl;
+        if (kernel_length != 0 && (shortest_window_length == 0 || kernel_length < shortest_window_length)) {
+            shortest_window_length = kernel_length;
+        }
+    }
+    int remez_length = shortest_kernel_length([&](int length) {
+        return create_fir_filter_remez(LOW_PASS, passband_edge, stopband_edge, 1.0f,
+                                       (float) (pass_ripple / stop_ripple), length, sample_rate);
+    }, passband_edge, stopband_edge, pass_ripple, stop_ripple);
+    std::cout << "kaiser (60 dB specification, pass band ripple not checked): "
+              << fir_kaiser_kernel_length(60.0f, stopband_edge - passband_edge, sample_rate) << " taps" << std::endl;
+    std::cout << "remez: " << remez_length << " taps" << std::endl;
+
+    ASSERT_NE(remez_length, 0);
+    ASSERT_NE(shortest_window_length, 0);
+    ASSERT_LT(remez_length, shortest_window_length);
+}
+
+// ================================================
+// = UNIT TESTS: convert_fir_filter_minimum_phase =
+// ================================================
+
+// Group delay at zero frequency, sum(n h[n]) / sum(h[n]), in samples
+static double dc_group_delay(const FIRFilter *filter) {
+    double weighted_sum = 0.0, sum = 0.0;
+    for (int n = 0; n < filter->kernel_length; ++n) {
+        weighted_sum += n * (double) filter->coefficients[n];
+        sum += filter->coefficients[n];
+    }
+    return weighted_sum / sum;
+}
+
+// The minimum-phase filter has the magnitude response of the linear-phase filter, with a fraction of its delay
+TEST(FIRFilterMinimumPhaseTest, SameMagnitudeResponse) {
+    WindowType windows[] = {HAMMING, BLACKMAN, KAISER_B8, KAISER_B10};
+    for (FilterType type : {LOW_PASS, HIGH_PASS}) {
+        for (WindowType window : windows) {
+            FIRFilter *filter = create_fir_filter(type, window, 1000.0f, 201, 8000.0f);
+            FIRFilter *minimum_phase = convert_fir_filter_minimum_phase(filter, 0);
+            ASSERT_NE(minimum_phase, nullptr);
+            ASSERT_EQ(minimum_phase->kernel_length, filter->kernel_length);
+            ASSERT_FALSE(minimum_phase->is_symmetric);
+
+            // The cepstrum of the stop band zeros aliases slightly, below -85 dB
+            for (double freq = 0.0; freq <= 4000.0; freq += 5.0) {
+                ASSERT_NEAR(magnitude_response(minimum_phase, freq), magnitude_response(filter, freq), 5e-5)
+                                            << "at " << freq << " Hz, window " << window;
+            }
+            if (type == LOW_PASS) {
+                double delay = dc_group_delay(minimum_phase);
+                EXPECT_LT(delay, 0.15 * (filter->kernel_length - 1) / 2);
+                std::cout << "Window " << window << ": group delay " << delay << " samples instead of "
+                          << (filter->kernel_length - 1) / 2 << std::endl;
+            }
+            destroy_fir_filter(filter);
+            destroy_fir_filter(minimum_phase);
+        }
+    }
+}
+
+// Of all filters with the same magnitude response, the minimum-phase one has the most energy in its first n taps
+TEST(FIRFilterMinimumPhaseTest, EnergyConcentratedInFirstTaps) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B8, 600.0f, 151, 8000.0f);
+    FIRFilter *minimum_phase = convert_fir_filter_minimum_phase(filter, 0);
+    ASSERT_NE(minimum_phase, nullptr);
+    double energy = 0.0, minimum_phase_energy = 0.0;
+    for (int n = 0; n < filter->kernel_length; ++n) {
+        energy += std::pow(filter->coefficients[n], 2);
+        minimum_phase_energy += std::pow(minimum_phase->coefficients[n], 2);
+        ASSERT_GE(minimum_phase_energy, energy - 1e-5 * energy) << "at tap " << n;
+    }
+    ASSERT_NEAR(minimum_phase_energy, energy, 1e-5);
+    destroy_fir_filter(filter);
+    destroy_fir_filter(minimum_phase);
+}
+
+// A truncated minimum-phase filter is the start of the full one, and every engine applies it
+TEST(FIRFilterMinimumPhaseTest, Truncation) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B10, 1000.0f, 201, 8000.0f);
+    FIRFilter *minimum_phase = convert_fir_filter_minimum_phase(filter, 0);
+    FIRFilter *truncated = convert_fir_filter_minimum_phase(filter, 101);
+    ASSERT_NE(minimum_phase, nullptr);
+    ASSERT_NE(truncated, nullptr);
+    ASSERT_EQ(truncated->kernel_length, 101);
+    compare_arrays(truncated->coefficients, minimum_phase->coefficients, truncated->kernel_length, 0.0f);
+
+    // Half the taps keep the pass band within 0.2 dB
+    for (double freq = 0.0; freq <= 800.0; freq += 10.0) {
+        ASSERT_NEAR(20.0 * std::log10(magnitude_response(truncated, freq) / magnitude_response(filter, freq)), 0.0, 0.2);
+    }
+
+    const int signal_length = 4000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(truncated, input_signal.data(), expected.data(), signal_length);
+    apply_fir_filter_simd(truncated, input_signal.data(), output_signal.data(), signal_length);
+    compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-5f);
+
+    ASSERT_EQ(convert_fir_filter_minimum_phase(filter, 202), nullptr);
+    ASSERT_EQ(convert_fir_filter_minimum_phase(filter, -1), nullptr);
+    ASSERT_EQ(convert_fir_filter_minimum_phase(nullptr, 0), nullptr);
+    destroy_fir_filter(filter);
+    destroy_fir_filter(minimum_phase);
+    destroy_fir_filter(truncated);
+}
 
 // ================================
 // = UNIT TESTS: apply_fir_filter =
@@ -357,6 +815,1785 @@ TEST(FIRFilterApplyTest, EdgeTests) {
 }
 
 
+// =====================================
+// = UNIT TESTS: apply_fir_filter_simd =
+// =====================================
+
+// Every instruction set level must match the direct convolution, including the outputs
+// that do not fill a whole block of vectors
+TEST(FIRFilterApplySimdTest, AllLevelsMatchDirectConvolution) {
+    std::cout << "Detected instruction set level: " << fir_simd_level_name(fir_simd_detect()) << std::endl;
+    std::vector<int> kernel_lengths = {3, 11, 101, 1001};
+    std::vector<int> signal_lengths = {1, 10, 77, 1000, 5003};
+    std::vector<FIRSimdLevel> levels = {FIR_SIMD_SCALAR, FIR_SIMD_SSE41, FIR_SIMD_AVX2, FIR_SIMD_AVX512};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(HIGH_PASS, HAMMING, 1000.0f, kernel_length, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            std::vector<float> expected(signal_length);
+            std::vector<float> output_signal(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+            apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+            for (FIRSimdLevel level : levels) {
+                apply_fir_filter_simd_level(level, filter, input_signal.data(), output_signal.data(), signal_length);
+                compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+            }
+            apply_fir_filter_simd(filter, input_signal.data(), output_signal.data(), signal_length);
+            compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Without folding, the scalar level keeps the summation order of apply_fir_filter
+TEST(FIRFilterApplySimdTest, ScalarLevelIsExact) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 1000.0f, 101, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    filter->is_symmetric = 0;
+
+    const int signal_length = 1000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+    apply_fir_filter_simd_level(FIR_SIMD_SCALAR, filter, input_signal.data(), output_signal.data(), signal_length);
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_EQ(output_signal[i], expected[i]);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+// Designed filters are symmetric, a modified filter is not
+TEST(FIRFilterApplySimdTest, SymmetryDetection) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, KAISER_B6, 1000.0f, 51, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_TRUE(filter->is_symmetric);
+
+    filter->coefficients[3] += 0.01f;
+    detect_fir_filter_structure(filter);
+    ASSERT_FALSE(filter->is_symmetric);
+
+    destroy_fir_filter(filter);
+}
+
+// The folded kernels of every level must match the unfolded direct convolution, for odd and even
+// kernel lengths, and the unfolded kernels must still be used for asymmetric filters
+TEST(FIRFilterApplySimdTest, FoldedKernelsMatchDirectConvolution) {
+    std::vector<int> kernel_lengths = {2, 3, 10, 101, 1000};
+    std::vector<FIRSimdLevel> levels = {FIR_SIMD_SCALAR, FIR_SIMD_SSE41, FIR_SIMD_AVX2, FIR_SIMD_AVX512};
+    const int signal_length = 3001;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    for (int kernel_length : kernel_lengths) {
+        for (int symmetric = 0; symmetric < 2; ++symmetric) {
+            // Build a symmetric (or slightly asymmetric) kernel of any length by hand
+            FIRFilter filter = {LOW_PASS, RECT, 1000.0f, kernel_length, 8000.0f, nullptr, 0};
+            std::vector<float> coefficients(kernel_length);
+            fill_random_signal(coefficients.data(), (kernel_length + 1) / 2, kernel_length);
+            for (int n = 0; n < kernel_length / 2; ++n) {
+                coefficients[kernel_length - 1 - n] = coefficients[n];
+            }
+            if (!symmetric) coefficients[0] += 0.5f;
+            filter.coefficients = coefficients.data();
+            detect_fir_filter_structure(&filter);
+            ASSERT_EQ(filter.is_symmetric, symmetric);
+
+            apply_fir_filter(&filter, input_signal.data(), expected.data(), signal_length);
+            for (FIRSimdLevel level : levels) {
+                apply_fir_filter_simd_level(level, &filter, input_signal.data(), output_signal.data(),
+                                            signal_length);
+                compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+            }
+        }
+    }
+}
+
+// Filters with the cutoff at a quarter of the sample rate are half-band filters
+TEST(FIRFilterApplySimdTest, HalfBandDetection) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B8, 2000.0f, 101, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_TRUE(filter->is_half_band);
+    zero_fir_filter_half_band_taps(filter);
+    for (int d = 2; d <= 50; d += 2) {
+        ASSERT_EQ(filter->coefficients[50 - d], 0.0f);
+        ASSERT_EQ(filter->coefficients[50 + d], 0.0f);
+    }
+    ASSERT_EQ(filter->coefficients[50], 0.5f);
+    ASSERT_NE(filter->coefficients[49], 0.0f);
+    destroy_fir_filter(filter);
+
+    filter = create_fir_filter(HIGH_PASS, HAMMING, 2000.0f, 51, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_TRUE(filter->is_half_band);
+    destroy_fir_filter(filter);
+
+    filter = create_fir_filter(LOW_PASS, KAISER_B8, 1000.0f, 101, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_FALSE(filter->is_half_band);
+    float coefficient = filter->coefficients[10];
+    zero_fir_filter_half_band_taps(filter);
+    ASSERT_EQ(filter->coefficients[10], coefficient);
+    destroy_fir_filter(filter);
+}
+
+// The half-band kernels of every level must match the direct convolution, with and without exact zeroing
+TEST(FIRFilterApplySimdTest, HalfBandKernelsMatchDirectConvolution) {
+    std::vector<int> kernel_lengths = {3, 5, 7, 99, 1001};
+    std::vector<FIRSimdLevel> levels = {FIR_SIMD_SCALAR, FIR_SIMD_SSE41, FIR_SIMD_AVX2, FIR_SIMD_AVX512};
+    const int signal_length = 3001;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 12000.0f, kernel_length, 48000.0f);
+        ASSERT_NE(filter, nullptr);
+        ASSERT_TRUE(filter->is_half_band);
+        for (int zeroed = 0; zeroed < 2; ++zeroed) {
+            if (zeroed) zero_fir_filter_half_band_taps(filter);
+            apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+            for (FIRSimdLevel level : levels) {
+                apply_fir_filter_simd_level(level, filter, input_signal.data(), output_signal.data(),
+                                            signal_length);
+                compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+            }
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Null tests
+TEST(FIRFilterApplySimdTest, NullTests) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    int signal_length = sizeof(input_signal) / sizeof(input_signal[0]);
+
+    apply_fir_filter_simd(nullptr, input_signal, output_signal, signal_length);
+    apply_fir_filter_simd(filter, nullptr, output_signal, signal_length);
+    apply_fir_filter_simd(filter, input_signal, nullptr, signal_length);
+    // Expect no change in output signal
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_EQ(output_signal[i], 0.0);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+
+// =========================================
+// = UNIT TESTS: apply_fir_filter_parallel =
+// =========================================
+
+// Any thread count must give bit-identical results to the serial paths, also with a reused pool
+TEST(FIRFilterParallelTest, BitIdenticalToSerial) {
+    const int signal_length = 5 * PARALLEL_MIN_CHUNK_LENGTH + 123;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> expected_simd(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, 101, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+    apply_fir_filter_simd(filter, input_signal.data(), expected_simd.data(), signal_length);
+
+    std::vector<int> thread_counts = {1, 2, 3, 8};
+    for (int thread_count : thread_counts) {
+        FIRThreadPool *pool = create_fir_thread_pool(thread_count);
+        ASSERT_NE(pool, nullptr);
+        ASSERT_EQ(fir_thread_pool_size(pool), thread_count);
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            std::fill(output_signal.begin(), output_signal.end(), 0.0f);
+            apply_fir_filter_parallel(pool, filter, input_signal.data(), output_signal.data(), signal_length);
+            for (int i = 0; i < signal_length; ++i) {
+                ASSERT_EQ(output_signal[i], expected[i]) << thread_count << " threads, sample " << i;
+            }
+
+            std::fill(output_signal.begin(), output_signal.end(), 0.0f);
+            apply_fir_filter_simd_parallel(pool, filter, input_signal.data(), output_signal.data(), signal_length);
+            for (int i = 0; i < signal_length; ++i) {
+                ASSERT_EQ(output_signal[i], expected_simd[i]) << thread_count << " threads, sample " << i;
+            }
+        }
+        destroy_fir_thread_pool(pool);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+// Signals shorter than one chunk and than the kernel
+TEST(FIRFilterParallelTest, ShortSignals) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, BLACKMAN, 1000.0f, 31, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRThreadPool *pool = create_fir_thread_pool(0);
+    ASSERT_NE(pool, nullptr);
+    ASSERT_GE(fir_thread_pool_size(pool), 1);
+
+    std::vector<int> signal_lengths = {0, 1, 20, 1000};
+    for (int signal_length : signal_lengths) {
+        std::vector<float> input_signal(signal_length + 1);
+        std::vector<float> expected(signal_length + 1);
+        std::vector<float> output_signal(signal_length + 1);
+        fill_random_signal(input_signal.data(), signal_length);
+        apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+        apply_fir_filter_parallel(pool, filter, input_signal.data(), output_signal.data(), signal_length);
+        for (int i = 0; i < signal_length; ++i) {
+            ASSERT_EQ(output_signal[i], expected[i]);
+        }
+    }
+
+    destroy_fir_thread_pool(pool);
+    destroy_fir_filter(filter);
+}
+
+// Null and invalid thread count tests
+TEST(FIRFilterParallelTest, InvalidParameters) {
+    ASSERT_EQ(create_fir_thread_pool(-1), nullptr);
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRThreadPool *pool = create_fir_thread_pool(2);
+    ASSERT_NE(pool, nullptr);
+
+    float input_signal[] = {1.0, 2.0, 3.0};
+    float output_signal[] = {0.0, 0.0, 0.0};
+    apply_fir_filter_parallel(nullptr, filter, input_signal, output_signal, 3);
+    apply_fir_filter_parallel(pool, nullptr, input_signal, output_signal, 3);
+    apply_fir_filter_simd_parallel(pool, filter, nullptr, output_signal, 3);
+    apply_fir_filter_simd_parallel(pool, filter, input_signal, output_signal, -1);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+
+    destroy_fir_thread_pool(pool);
+    destroy_fir_thread_pool(nullptr);
+    destroy_fir_filter(filter);
+}
+
+
+// ======================================
+// = UNIT TESTS: apply_fir_filter_tiled =
+// ======================================
+
+// Any tile length must give bit-identical results to apply_fir_filter, also when the kernel is longer than the signal
+TEST(FIRFilterTiledTest, BitIdenticalToApplyFirFilter) {
+    std::vector<int> kernel_lengths = {3, 100, 2049, 5000};
+    std::vector<int> signal_lengths = {1, 1000, 4321};
+    std::vector<int> tile_lengths = {1, 7, 64, 1000, 0};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, kernel_length, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            std::vector<float> expected(signal_length);
+            std::vector<float> output_signal(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+            apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+            for (int tile_length : tile_lengths) {
+                // A single-sample tile is slow for long kernels
+                if (tile_length == 1 && kernel_length * signal_length > 1000000) {
+                    continue;
+                }
+                apply_fir_filter_tiled(filter, input_signal.data(), output_signal.data(), signal_length, tile_length);
+                for (int i = 0; i < signal_length; ++i) {
+                    ASSERT_EQ(output_signal[i], expected[i])
+                                                << "kernel_length " << kernel_length << ", tile_length " << tile_length
+                                                << ", sample " << i;
+                }
+            }
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// The tuned tile length is one of the candidates and stays the same
+TEST(FIRFilterTiledTest, TunedTileLength) {
+    int tile_length = fir_tiled_tune_tile_length();
+    std::cout << "Tuned tile length: " << tile_length << std::endl;
+    ASSERT_GE(tile_length, 128);
+    ASSERT_LE(tile_length, 4096);
+    ASSERT_EQ(tile_length & (tile_length - 1), 0);
+    ASSERT_EQ(fir_tiled_tune_tile_length(), tile_length);
+}
+
+// Null and invalid tile length tests
+TEST(FIRFilterTiledTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    float input_signal[] = {1.0, 2.0, 3.0};
+    float output_signal[] = {0.0, 0.0, 0.0};
+    apply_fir_filter_tiled(nullptr, input_signal, output_signal, 3, 0);
+    apply_fir_filter_tiled(filter, nullptr, output_signal, 3, 0);
+    apply_fir_filter_tiled(filter, input_signal, output_signal, 3, -1);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+    destroy_fir_filter(filter);
+}
+
+
+// ===========================
+// = UNIT TESTS: fir_planner =
+// ===========================
+
+// Without wisdom, short kernels stay direct and long kernels go to the transforms within the latency budget
+TEST(FIRPlannerTest, PlansWithoutWisdom) {
+    fir_planner_forget_wisdom();
+    ASSERT_EQ(fir_planner_has_wisdom(), 0);
+
+    ASSERT_EQ(fir_plan_engine(31, 100000, FIR_LATENCY_UNBOUNDED), FIR_ENGINE_SIMD);
+    ASSERT_EQ(fir_plan_engine(20000, 1000000, FIR_LATENCY_UNBOUNDED), FIR_ENGINE_FFT);
+    // Too small a budget for one transform block, but enough for small partitions
+    ASSERT_EQ(fir_plan_engine(20000, 1000000, 256), FIR_ENGINE_PARTITIONED);
+    // No latency at all leaves the direct engines
+    ASSERT_EQ(fir_plan_engine(20000, 1000000, 0), FIR_ENGINE_TILED);
+    // A signal shorter than the kernel does not amortize the transforms
+    ASSERT_EQ(fir_plan_engine(20000, 1000, FIR_LATENCY_UNBOUNDED), FIR_ENGINE_TILED);
+    ASSERT_STREQ(fir_engine_name(FIR_ENGINE_PARTITIONED), "partitioned");
+}
+
+// Whatever engine is chosen, the output must match the direct convolution
+TEST(FIRPlannerTest, PlannedApplyMatchesDirectConvolution) {
+    fir_planner_forget_wisdom();
+    std::vector<int> kernel_lengths = {15, 5001};
+    std::vector<int> signal_lengths = {1, 777, 20000};
+    std::vector<int> latency_budgets = {FIR_LATENCY_UNBOUNDED, 0, 100};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, kernel_length, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            std::vector<float> expected(signal_length);
+            std::vector<float> output_signal(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+            apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+            for (int latency_budget : latency_budgets) {
+                apply_fir_filter_planned(filter, input_signal.data(), output_signal.data(), signal_length,
+                                         latency_budget);
+                compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+            }
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Calibrated wisdom survives a round trip through the wisdom file, foreign and broken files are rejected
+TEST(FIRPlannerTest, WisdomRoundTrip) {
+    const char *wisdom_file = "test_wisdom.txt";
+    fir_planner_forget_wisdom();
+    ASSERT_EQ(fir_planner_save_wisdom(wisdom_file), -1);
+
+    fir_planner_calibrate();
+    ASSERT_EQ(fir_planner_has_wisdom(), 1);
+    std::vector<int> kernel_lengths = {8, 100, 1000, 10000};
+    std::vector<int> latency_budgets = {FIR_LATENCY_UNBOUNDED, 0, 512};
+    std::vector<FIREngine> calibrated;
+    for (int kernel_length : kernel_lengths) {
+        for (int latency_budget : latency_budgets) {
+            FIREngine engine = fir_plan_engine(kernel_length, 100000, latency_budget);
+            std::cout << "kernel_length " << kernel_length << ", latency budget " << latency_budget << ": "
+                      << fir_engine_name(engine) << std::endl;
+            // The chosen engine has to respect the latency budget
+            if (latency_budget == 0) {
+                ASSERT_NE(engine, FIR_ENGINE_FFT);
+                ASSERT_NE(engine, FIR_ENGINE_PARTITIONED);
+            }
+            calibrated.push_back(engine);
+        }
+    }
+    ASSERT_EQ(fir_planner_save_wisdom(wisdom_file), 0);
+
+    fir_planner_forget_wisdom();
+    ASSERT_EQ(fir_planner_load_wisdom(wisdom_file), 0);
+    ASSERT_EQ(fir_planner_has_wisdom(), 1);
+    int index = 0;
+    for (int kernel_length : kernel_lengths) {
+        for (int latency_budget : latency_budgets) {
+            ASSERT_EQ(fir_plan_engine(kernel_length, 100000, latency_budget), calibrated[index++]);
+        }
+    }
+
+    // Wisdom of another instruction set level, a broken line and a missing file
+    fir_planner_forget_wisdom();
+    FILE *file = fopen(wisdom_file, "w");
+    ASSERT_NE(file, nullptr);
+    fprintf(file, "level %s\n16 simd 0 1e-9\n", fir_simd_detect() == FIR_SIMD_SCALAR ? "avx2" : "scalar");
+    fclose(file);
+    ASSERT_EQ(fir_planner_load_wisdom(wisdom_file), -1);
+    file = fopen(wisdom_file, "w");
+    ASSERT_NE(file, nullptr);
+    fprintf(file, "level %s\n17 simd 0 1e-9\n", fir_simd_level_name(fir_simd_detect()));
+    fclose(file);
+    ASSERT_EQ(fir_planner_load_wisdom(wisdom_file), -1);
+    ASSERT_EQ(fir_planner_has_wisdom(), 0);
+    remove(wisdom_file);
+    ASSERT_EQ(fir_planner_load_wisdom(wisdom_file), -1);
+}
+
+
+// =================================
+// = UNIT TESTS: fir_filter_double =
+// =================================
+
+// The double design matches the float design to float precision, and the conversion rounds every coefficient once
+TEST(FIRFilterDoubleTest, DesignMatchesFloatDesign) {
+    WindowType windows[] = {RECT, HANNING, HAMMING, BLACKMAN, KAISER_B6, KAISER_B8, KAISER_B10};
+    for (WindowType window : windows) {
+        FIRFilter *filter = create_fir_filter(HIGH_PASS, window, 1000.0f, 100, 8000.0f);
+        FIRFilterDouble *filter_double = create_fir_filter_double(HIGH_PASS, window, 1000.0, 100, 8000.0);
+        ASSERT_NE(filter, nullptr);
+        ASSERT_NE(filter_double, nullptr);
+        ASSERT_EQ(filter_double->kernel_length, filter->kernel_length);
+        ASSERT_TRUE(filter_double->is_symmetric);
+        for (int j = 0; j < filter->kernel_length; ++j) {
+            ASSERT_NEAR(filter_double->coefficients[j], filter->coefficients[j], 1e-6) << "window " << window;
+        }
+
+        FIRFilter *converted = convert_fir_filter_double_to_float(filter_double);
+        ASSERT_NE(converted, nullptr);
+        ASSERT_EQ(converted->kernel_length, filter_double->kernel_length);
+        for (int j = 0; j < converted->kernel_length; ++j) {
+            ASSERT_EQ(converted->coefficients[j], (float) filter_double->coefficients[j]);
+        }
+        destroy_fir_filter(converted);
+        destroy_fir_filter_double(filter_double);
+        destroy_fir_filter(filter);
+    }
+}
+
+// Every level stays within a few double roundings of the scalar kernel, for symmetric and non-symmetric filters
+TEST(FIRFilterDoubleTest, AllLevelsMatchScalar) {
+    std::vector<int> kernel_lengths = {3, 5, 64, 301};
+    std::vector<int> signal_lengths = {1, 50, 1003};
+
+    for (int kernel_length : kernel_lengths) {
+        for (int symmetric = 0; symmetric < 2; ++symmetric) {
+            FIRFilterDouble *filter = create_fir_filter_double(LOW_PASS, HAMMING, 1000.0, kernel_length, 8000.0);
+            ASSERT_NE(filter, nullptr);
+            if (!symmetric && filter->kernel_length > 1) {
+                filter->coefficients[0] += 0.25;
+                filter->is_symmetric = 0;
+            }
+            for (int signal_length : signal_lengths) {
+                std::vector<float> random_signal(signal_length);
+                fill_random_signal(random_signal.data(), signal_length);
+                std::vector<double> input_signal(random_signal.begin(), random_signal.end());
+                std::vector<double> expected(signal_length);
+                apply_fir_filter_double_level(FIR_SIMD_SCALAR, filter, input_signal.data(), expected.data(),
+                                              signal_length);
+                for (int level = FIR_SIMD_SSE41; level <= FIR_SIMD_AVX512; ++level) {
+                    std::vector<double> output_signal(signal_length);
+                    apply_fir_filter_double_level((FIRSimdLevel) level, filter, input_signal.data(),
+                                                  output_signal.data(), signal_length);
+                    for (int i = 0; i < signal_length; ++i) {
+                        ASSERT_NEAR(output_signal[i], expected[i], 1e-13)
+                                                    << "kernel_length " << kernel_length << ", level " << level
+                                                    << ", sample " << i;
+                    }
+                }
+            }
+            destroy_fir_filter_double(filter);
+        }
+    }
+}
+
+// A long, narrow filter: the double path stays at the double rounding floor, far below the float path
+TEST(FIRFilterDoubleTest, LongNarrowFilterPrecision) {
+    const int kernel_length = 20001;
+    const int signal_length = 24000;
+    FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B10, 10.0f, kernel_length, 48000.0f);
+    FIRFilterDouble *filter_double = create_fir_filter_double(LOW_PASS, KAISER_B10, 10.0, kernel_length, 48000.0);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_NE(filter_double, nullptr);
+
+    std::vector<float> input_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    std::vector<double> input_double(input_signal.begin(), input_signal.end());
+    std::vector<float> output_signal(signal_length);
+    std::vector<double> output_double(signal_length);
+    apply_fir_filter_simd(filter, input_signal.data(), output_signal.data(), signal_length);
+    apply_fir_filter_double(filter_double, input_double.data(), output_double.data(), signal_length);
+
+    // Errors against the double design convolved in long double, relative to the output energy
+    double float_error = 0.0, double_error = 0.0, energy = 0.0;
+    for (int i = kernel_length - 1; i < signal_length; i += 97) {
+        long double sum = 0.0L;
+        for (int j = 0; j < kernel_length; ++j) {
+            sum += (long double) filter_double->coefficients[j] * input_double[i - j];
+        }
+        float_error += std::pow(output_signal[i] - (double) sum, 2);
+        double_error += std::pow(output_double[i] - (double) sum, 2);
+        energy += std::pow((double) sum, 2);
+    }
+    double float_error_db = 10.0 * std::log10(float_error / energy);
+    double double_error_db = 10.0 * std::log10(double_error / energy);
+    std::cout << "Relative error, float path: " << float_error_db << " dB, double path: " << double_error_db
+              << " dB" << std::endl;
+    ASSERT_LT(double_error_db, -250.0);
+    ASSERT_LT(double_error_db, float_error_db - 100.0);
+    destroy_fir_filter_double(filter_double);
+    destroy_fir_filter(filter);
+}
+
+// Null and invalid parameter tests
+TEST(FIRFilterDoubleTest, InvalidParameters) {
+    ASSERT_EQ(create_fir_filter_double(LOW_PASS, HAMMING, 0.0, 11, 8000.0), nullptr);
+    ASSERT_EQ(create_fir_filter_double(LOW_PASS, HAMMING, 1000.0, 0, 8000.0), nullptr);
+    ASSERT_EQ(convert_fir_filter_double_to_float(nullptr), nullptr);
+
+    FIRFilterDouble *filter = create_fir_filter_double(LOW_PASS, HANNING, 1000.0, 11, 8000.0);
+    ASSERT_NE(filter, nullptr);
+    double input_signal[] = {1.0, 2.0, 3.0};
+    double output_signal[] = {0.0, 0.0, 0.0};
+    apply_fir_filter_double(nullptr, input_signal, output_signal, 3);
+    apply_fir_filter_double(filter, nullptr, output_signal, 3);
+    apply_fir_filter_double(filter, input_signal, output_signal, -1);
+    for (double value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+    destroy_fir_filter_double(filter);
+}
+
+
+// ====================================
+// = UNIT TESTS: apply_fir_filter_q15 =
+// ====================================
+
+// Exact Q15 reference: 64-bit sum of the products, rounded to nearest and saturated to int16
+static std::vector<int16_t> reference_q15(const FIRFilterQ15 *filter, const std::vector<int16_t> &input_signal) {
+    std::vector<int16_t> output_signal(input_signal.size());
+    for (int i = 0; i < (int) input_signal.size(); ++i) {
+        int64_t sum = 0;
+        for (int j = 0; j < filter->kernel_length && j <= i; ++j) {
+            sum += (int64_t) filter->coefficients[j] * input_signal[i - j];
+        }
+        int64_t value = (sum + (1 << 14)) >> 15;
+        output_signal[i] = (int16_t) std::max<int64_t>(INT16_MIN, std::min<int64_t>(INT16_MAX, value));
+    }
+    return output_signal;
+}
+
+// Helper function to fill an int16 signal with reproducible pseudo-random values of the given amplitude
+static void fill_random_int16_signal(std::vector<int16_t> &signal, int amplitude, unsigned int seed = 1) {
+    srand(seed);
+    for (int16_t &sample : signal) {
+        sample = (int16_t) (rand() % (2 * amplitude + 1) - amplitude);
+    }
+}
+
+// Quantization rounds the coefficients to Q15 within the symmetric range
+TEST(FIRFilterQ15Test, QuantizeCoefficients) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, 31, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    filter->coefficients[0] = 1.5f;
+    filter->coefficients[1] = -1.0f;
+    FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+    ASSERT_NE(quantized, nullptr);
+    ASSERT_EQ(quantized->kernel_length, 31);
+    ASSERT_EQ(quantized->coefficients[0], 32767);
+    ASSERT_EQ(quantized->coefficients[1], -32767);
+
+    int64_t absolute_sum = 0;
+    for (int j = 2; j < 31; ++j) {
+        ASSERT_NEAR(quantized->coefficients[j] / 32768.0, filter->coefficients[j], 0.5 / 32768.0 + 1e-9);
+    }
+    for (int j = 0; j < 31; ++j) {
+        absolute_sum += std::abs((int) quantized->coefficients[j]);
+    }
+    ASSERT_EQ(quantized->absolute_sum, absolute_sum);
+    destroy_fir_filter_q15(quantized);
+    destroy_fir_filter(filter);
+}
+
+// Every SIMD level gives exactly the integer reference, with 32-bit (unit gain) and 64-bit (high gain) accumulation
+TEST(FIRFilterQ15Test, AllLevelsMatchReference) {
+    std::vector<int> kernel_lengths = {1, 7, 32, 63, 100, 257};
+    std::vector<int> signal_lengths = {1, 5, 40, 1001};
+    std::vector<float> gains = {1.0f, 3.0f};
+
+    for (float gain : gains) {
+        for (int kernel_length : kernel_lengths) {
+            FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, kernel_length, 8000.0f);
+            ASSERT_NE(filter, nullptr);
+            for (int j = 0; j < kernel_length; ++j) {
+                filter->coefficients[j] *= gain;
+            }
+            FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+            ASSERT_NE(quantized, nullptr);
+
+            for (int signal_length : signal_lengths) {
+                std::vector<int16_t> input_signal(signal_length);
+                fill_random_int16_signal(input_signal, 32767);
+                input_signal[0] = INT16_MIN;
+                std::vector<int16_t> expected = reference_q15(quantized, input_signal);
+
+                for (int level = FIR_SIMD_SCALAR; level <= FIR_SIMD_AVX512; ++level) {
+                    std::vector<int16_t> output_signal(signal_length, 0);
+                    apply_fir_filter_q15_level((FIRSimdLevel) level, quantized, input_signal.data(),
+                                               output_signal.data(), signal_length);
+                    ASSERT_EQ(output_signal, expected)
+                                                << "gain " << gain << ", kernel_length " << kernel_length
+                                                << ", signal_length " << signal_length << ", level " << level;
+                }
+            }
+            destroy_fir_filter_q15(quantized);
+            destroy_fir_filter(filter);
+        }
+    }
+}
+
+// A high-gain filter saturates the output instead of wrapping around
+TEST(FIRFilterQ15Test, SaturatesOutput) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, RECT, 100.0f, 64, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    for (int j = 0; j < 64; ++j) {
+        filter->coefficients[j] = 0.5f;
+    }
+    FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+    ASSERT_NE(quantized, nullptr);
+
+    std::vector<int16_t> input_signal(200, INT16_MAX);
+    std::fill(input_signal.begin() + 100, input_signal.end(), INT16_MIN);
+    std::vector<int16_t> output_signal(200);
+    apply_fir_filter_q15(quantized, input_signal.data(), output_signal.data(), 200);
+    ASSERT_EQ(output_signal[99], INT16_MAX);
+    ASSERT_EQ(output_signal[199], INT16_MIN);
+    destroy_fir_filter_q15(quantized);
+    destroy_fir_filter(filter);
+}
+
+// The Q15 output stays within a few LSBs of the float filter on the same samples
+TEST(FIRFilterQ15Test, CloseToFloatFilter) {
+    const int signal_length = 4000;
+    FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 1000.0f, 101, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+    ASSERT_NE(quantized, nullptr);
+
+    std::vector<int16_t> input_signal(signal_length);
+    fill_random_int16_signal(input_signal, 16000);
+    std::vector<float> input_float(input_signal.begin(), input_signal.end());
+    std::vector<float> expected(signal_length);
+    std::vector<int16_t> output_signal(signal_length);
+    apply_fir_filter(filter, input_float.data(), expected.data(), signal_length);
+    apply_fir_filter_q15(quantized, input_signal.data(), output_signal.data(), signal_length);
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_NEAR(output_signal[i], expected[i], 32.0) << "sample " << i;
+    }
+    destroy_fir_filter_q15(quantized);
+    destroy_fir_filter(filter);
+}
+
+// Null and invalid parameter tests
+TEST(FIRFilterQ15Test, InvalidParameters) {
+    ASSERT_EQ(quantize_fir_filter_q15(nullptr), nullptr);
+
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRFilterQ15 *quantized = quantize_fir_filter_q15(filter);
+    ASSERT_NE(quantized, nullptr);
+    int16_t input_signal[] = {1, 2, 3};
+    int16_t output_signal[] = {0, 0, 0};
+    apply_fir_filter_q15(nullptr, input_signal, output_signal, 3);
+    apply_fir_filter_q15(quantized, nullptr, output_signal, 3);
+    apply_fir_filter_q15(quantized, input_signal, output_signal, -1);
+    for (int16_t value : output_signal) {
+        ASSERT_EQ(value, 0);
+    }
+    destroy_fir_filter_q15(quantized);
+    destroy_fir_filter(filter);
+}
+
+
+// =====================================
+// = UNIT TESTS: apply_fir_filter_half =
+// =====================================
+
+// Known values round to nearest even, overflow and flush as specified
+TEST(FIRFilterHalfTest, ConversionValues) {
+    float values[] = {1.0f, -0.5f, 65504.0f, 65520.0f, 1.0f + 1.0f / 4096.0f, 5.9604645e-8f, 1e-40f};
+    uint16_t fp16[7], bf16[7];
+    fir_float_to_half(FIR_HALF_FP16, values, fp16, 7);
+    fir_float_to_half(FIR_HALF_BF16, values, bf16, 7);
+    uint16_t expected_fp16[] = {0x3C00, 0xB800, 0x7BFF, 0x7C00, 0x3C00, 0x0001, 0x0000};
+    uint16_t expected_bf16[] = {0x3F80, 0xBF00, 0x4780, 0x4780, 0x3F80, 0x3380, 0x0000};
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_EQ(fp16[i], expected_fp16[i]) << "value " << values[i];
+        ASSERT_EQ(bf16[i], expected_bf16[i]) << "value " << values[i];
+    }
+}
+
+// A round trip keeps every value within half a unit in the last place of the format
+TEST(FIRFilterHalfTest, ConversionRoundTrip) {
+    const int length = 1001;
+    std::vector<float> values(length);
+    fill_random_signal(values.data(), length);
+    std::vector<uint16_t> half(length);
+    std::vector<float> widened(length);
+
+    FIRHalfFormat formats[] = {FIR_HALF_FP16, FIR_HALF_BF16};
+    float epsilons[] = {1.0f / 2048.0f, 1.0f / 256.0f};
+    for (int k = 0; k < 2; ++k) {
+        fir_float_to_half(formats[k], values.data(), half.data(), length);
+        fir_half_to_float(formats[k], half.data(), widened.data(), length);
+        for (int i = 0; i < length; ++i) {
+            ASSERT_LE(std::fabs(widened[i] - values[i]), epsilons[k] * std::fabs(values[i]) + 1e-7f)
+                                        << "format " << formats[k] << ", value " << values[i];
+        }
+    }
+}
+
+// Every level equals the float kernel on the widened filter and signal, rounded once, across the block boundaries
+TEST(FIRFilterHalfTest, MatchesWidenedFloatFilter) {
+    std::vector<int> kernel_lengths = {1, 16, 63, 500};
+    std::vector<int> signal_lengths = {1, 100, 10000};
+    FIRHalfFormat formats[] = {FIR_HALF_FP16, FIR_HALF_BF16};
+
+    for (FIRHalfFormat format : formats) {
+        for (int kernel_length : kernel_lengths) {
+            FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, kernel_length, 8000.0f);
+            ASSERT_NE(filter, nullptr);
+            FIRFilterHalf *converted = convert_fir_filter_half(filter, format);
+            ASSERT_NE(converted, nullptr);
+            fir_half_to_float(format, converted->coefficients, filter->coefficients, filter->kernel_length);
+            detect_fir_filter_structure(filter);
+
+            for (int signal_length : signal_lengths) {
+                std::vector<float> input_signal(signal_length);
+                fill_random_signal(input_signal.data(), signal_length);
+                std::vector<uint16_t> input_half(signal_length);
+                fir_float_to_half(format, input_signal.data(), input_half.data(), signal_length);
+                fir_half_to_float(format, input_half.data(), input_signal.data(), signal_length);
+
+                for (int level = FIR_SIMD_SCALAR; level <= FIR_SIMD_AVX512; ++level) {
+                    std::vector<float> expected(signal_length);
+                    std::vector<uint16_t> expected_half(signal_length);
+                    std::vector<uint16_t> output_half(signal_length);
+                    apply_fir_filter_simd_level((FIRSimdLevel) level, filter, input_signal.data(), expected.data(),
+                                                signal_length);
+                    fir_float_to_half(format, expected.data(), expected_half.data(), signal_length);
+                    apply_fir_filter_half_level((FIRSimdLevel) level, converted, input_half.data(),
+                                                output_half.data(), signal_length);
+                    ASSERT_EQ(output_half, expected_half)
+                                                << "format " << format << ", kernel_length " << kernel_length
+                                                << ", signal_length " << signal_length << ", level " << level;
+                }
+            }
+            destroy_fir_filter_half(converted);
+            destroy_fir_filter(filter);
+        }
+    }
+}
+
+// Error of the 16-bit path against the float path on the same designed filter and signal
+TEST(FIRFilterHalfTest, AccuracyAgainstFloatPath) {
+    const int signal_length = 20000;
+    FIRHalfFormat formats[] = {FIR_HALF_FP16, FIR_HALF_BF16};
+    float tolerances[] = {2e-3f, 2e-2f};
+    std::vector<int> kernel_lengths = {31, 255};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 1000.0f, kernel_length, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        std::vector<float> input_signal(signal_length);
+        std::vector<float> expected(signal_length);
+        fill_random_signal(input_signal.data(), signal_length);
+        apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+        for (int k = 0; k < 2; ++k) {
+            FIRFilterHalf *converted = convert_fir_filter_half(filter, formats[k]);
+            ASSERT_NE(converted, nullptr);
+            std::vector<uint16_t> input_half(signal_length);
+            std::vector<uint16_t> output_half(signal_length);
+            std::vector<float> output_signal(signal_length);
+            fir_float_to_half(formats[k], input_signal.data(), input_half.data(), signal_length);
+            apply_fir_filter_half(converted, input_half.data(), output_half.data(), signal_length);
+            fir_half_to_float(formats[k], output_half.data(), output_signal.data(), signal_length);
+
+            double error_energy = 0.0, signal_energy = 0.0, max_error = 0.0;
+            for (int i = 0; i < signal_length; ++i) {
+                double error = (double) output_signal[i] - expected[i];
+                error_energy += error * error;
+                signal_energy += (double) expected[i] * expected[i];
+                max_error = std::max(max_error, std::fabs(error));
+            }
+            std::cout << (formats[k] == FIR_HALF_FP16 ? "FP16" : "BF16") << ", kernel_length " << kernel_length
+                      << ": max error " << max_error << ", SNR " << 10.0 * std::log10(signal_energy / error_energy)
+                      << " dB" << std::endl;
+            ASSERT_LE(max_error, tolerances[k]);
+            destroy_fir_filter_half(converted);
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Null and invalid parameter tests
+TEST(FIRFilterHalfTest, InvalidParameters) {
+    ASSERT_EQ(convert_fir_filter_half(nullptr, FIR_HALF_FP16), nullptr);
+
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_EQ(convert_fir_filter_half(filter, (FIRHalfFormat) 7), nullptr);
+    FIRFilterHalf *converted = convert_fir_filter_half(filter, FIR_HALF_FP16);
+    ASSERT_NE(converted, nullptr);
+    uint16_t input_signal[] = {0x3C00, 0x3C00, 0x3C00};
+    uint16_t output_signal[] = {0, 0, 0};
+    apply_fir_filter_half(nullptr, input_signal, output_signal, 3);
+    apply_fir_filter_half(converted, nullptr, output_signal, 3);
+    apply_fir_filter_half(converted, input_signal, output_signal, -1);
+    fir_float_to_half(FIR_HALF_BF16, nullptr, output_signal, 3);
+    for (uint16_t value : output_signal) {
+        ASSERT_EQ(value, 0);
+    }
+    destroy_fir_filter_half(converted);
+    destroy_fir_filter(filter);
+}
+
+
+// ========================================
+// = UNIT TESTS: apply_fir_filter_complex =
+// ========================================
+
+// I and Q equal the real engine on the separated components, bit for bit at every level
+TEST(FIRFilterComplexTest, MatchesSeparatedComponents) {
+    std::vector<int> kernel_lengths = {3, 8, 63, 201};
+    std::vector<float> cutoffs = {1000.0f, 2000.0f};
+    std::vector<int> signal_lengths = {1, 40, 1001};
+
+    for (float cutoff : cutoffs) {
+        for (int kernel_length : kernel_lengths) {
+            FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, cutoff, kernel_length, 8000.0f);
+            ASSERT_NE(filter, nullptr);
+            for (int signal_length : signal_lengths) {
+                std::vector<float> input_signal(2 * signal_length);
+                fill_random_signal(input_signal.data(), 2 * signal_length);
+                std::vector<float> in_phase(signal_length), quadrature(signal_length);
+                for (int i = 0; i < signal_length; ++i) {
+                    in_phase[i] = input_signal[2 * i];
+                    quadrature[i] = input_signal[2 * i + 1];
+                }
+
+                for (int level = FIR_SIMD_SCALAR; level <= FIR_SIMD_AVX512; ++level) {
+                    std::vector<float> output_signal(2 * signal_length);
+                    std::vector<float> expected_i(signal_length), expected_q(signal_length);
+                    apply_fir_filter_complex_level((FIRSimdLevel) level, filter, input_signal.data(),
+                                                   output_signal.data(), signal_length);
+                    apply_fir_filter_simd_level((FIRSimdLevel) level, filter, in_phase.data(), expected_i.data(),
+                                                signal_length);
+                    apply_fir_filter_simd_level((FIRSimdLevel) level, filter, quadrature.data(), expected_q.data(),
+                                                signal_length);
+                    for (int i = 0; i < signal_length; ++i) {
+                        ASSERT_EQ(output_signal[2 * i], expected_i[i]) << "level " << level << ", sample " << i;
+                        ASSERT_EQ(output_signal[2 * i + 1], expected_q[i]) << "level " << level << ", sample " << i;
+                    }
+                }
+            }
+            destroy_fir_filter(filter);
+        }
+    }
+}
+
+// Complex taps match a complex convolution in double at every level
+TEST(FIRFilterComplexTest, ComplexTapsMatchReference) {
+    std::vector<int> kernel_lengths = {1, 5, 64, 129};
+    std::vector<int> signal_lengths = {1, 30, 777};
+
+    for (int kernel_length : kernel_lengths) {
+        std::vector<float> coefficients(2 * kernel_length);
+        fill_random_signal(coefficients.data(), 2 * kernel_length, 7);
+        FIRFilterComplex *filter = create_fir_filter_complex(coefficients.data(), kernel_length);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(2 * signal_length);
+            fill_random_signal(input_signal.data(), 2 * signal_length);
+            std::vector<std::complex<double>> expected(signal_length);
+            for (int i = 0; i < signal_length; ++i) {
+                for (int j = 0; j < std::min(kernel_length, i + 1); ++j) {
+                    expected[i] += std::complex<double>(coefficients[2 * j], coefficients[2 * j + 1]) *
+                                   std::complex<double>(input_signal[2 * (i - j)], input_signal[2 * (i - j) + 1]);
+                }
+            }
+
+            for (int level = FIR_SIMD_SCALAR; level <= FIR_SIMD_AVX512; ++level) {
+                std::vector<float> output_signal(2 * signal_length);
+                apply_fir_filter_complex_taps_level((FIRSimdLevel) level, filter, input_signal.data(),
+                                                    output_signal.data(), signal_length);
+                for (int i = 0; i < signal_length; ++i) {
+                    ASSERT_NEAR(output_signal[2 * i], expected[i].real(), 1e-4) << "level " << level;
+                    ASSERT_NEAR(output_signal[2 * i + 1], expected[i].imag(), 1e-4) << "level " << level;
+                }
+            }
+        }
+        destroy_fir_filter_complex(filter);
+    }
+}
+
+// A shifted low-pass prototype passes a tone at the center frequency and rejects its mirror image
+TEST(FIRFilterComplexTest, ShiftedFilterSelectsOneSide) {
+    const int signal_length = 4000;
+    const float sample_rate = 8000.0f;
+    FIRFilter *prototype = create_fir_filter(LOW_PASS, BLACKMAN, 300.0f, 201, sample_rate);
+    ASSERT_NE(prototype, nullptr);
+    FIRFilterComplex *filter = shift_fir_filter_complex(prototype, 1500.0f);
+    ASSERT_NE(filter, nullptr);
+
+    std::vector<float> tone_gains;
+    for (float tone : {1500.0f, -1500.0f}) {
+        std::vector<float> input_signal(2 * signal_length);
+        for (int i = 0; i < signal_length; ++i) {
+            double phase = 2.0 * M_PI * tone * i / sample_rate;
+            input_signal[2 * i] = (float) std::cos(phase);
+            input_signal[2 * i + 1] = (float) std::sin(phase);
+        }
+        std::vector<float> output_signal(2 * signal_length);
+        apply_fir_filter_complex_taps(filter, input_signal.data(), output_signal.data(), signal_length);
+        int i = signal_length - 1;
+        tone_gains.push_back(std::hypot(output_signal[2 * i], output_signal[2 * i + 1]));
+    }
+    ASSERT_NEAR(tone_gains[0], 1.0f, 1e-3f);
+    ASSERT_LT(tone_gains[1], 1e-3f);
+    destroy_fir_filter_complex(filter);
+    destroy_fir_filter(prototype);
+}
+
+// Null and invalid parameter tests
+TEST(FIRFilterComplexTest, InvalidParameters) {
+    ASSERT_EQ(create_fir_filter_complex(nullptr, 3), nullptr);
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_EQ(shift_fir_filter_complex(nullptr, 100.0f), nullptr);
+    ASSERT_EQ(shift_fir_filter_complex(filter, 4000.0f), nullptr);
+    FIRFilterComplex *complex_filter = shift_fir_filter_complex(filter, 100.0f);
+    ASSERT_NE(complex_filter, nullptr);
+
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0};
+    apply_fir_filter_complex(nullptr, input_signal, output_signal, 2);
+    apply_fir_filter_complex(filter, nullptr, output_signal, 2);
+    apply_fir_filter_complex(filter, input_signal, output_signal, -1);
+    apply_fir_filter_complex_taps(nullptr, input_signal, output_signal, 2);
+    apply_fir_filter_complex_taps(complex_filter, input_signal, nullptr, 2);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+    destroy_fir_filter_complex(complex_filter);
+    destroy_fir_filter(filter);
+}
+
+
+// =============================================
+// = UNIT TESTS: apply_fir_filter_multichannel =
+// =============================================
+
+// Every channel of an interleaved or planar signal must match apply_fir_filter on that channel
+TEST(FIRFilterMultichannelTest, MatchesPerChannelApply) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, 63, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    const int frame_count = 500;
+    // Channel counts which exercise the full, single and partial vector paths
+    std::vector<int> channel_counts = {1, 3, 8, 16, 37, 64};
+    for (int channel_count : channel_counts) {
+        std::vector<float> planar(frame_count * channel_count);
+        std::vector<float> interleaved(frame_count * channel_count);
+        std::vector<float> expected(frame_count * channel_count);
+        std::vector<float> output_signal(frame_count * channel_count);
+        fill_random_signal(planar.data(), frame_count * channel_count);
+        for (int c = 0; c < channel_count; ++c) {
+            apply_fir_filter(filter, planar.data() + c * frame_count, expected.data() + c * frame_count, frame_count);
+            for (int i = 0; i < frame_count; ++i) {
+                interleaved[i * channel_count + c] = planar[c * frame_count + i];
+            }
+        }
+
+        apply_fir_filter_multichannel(filter, planar.data(), output_signal.data(), frame_count, channel_count,
+                                      FIR_LAYOUT_PLANAR);
+        compare_arrays(output_signal.data(), expected.data(), frame_count * channel_count, 1e-5);
+
+        apply_fir_filter_multichannel(filter, interleaved.data(), output_signal.data(), frame_count, channel_count,
+                                      FIR_LAYOUT_INTERLEAVED);
+        for (int c = 0; c < channel_count; ++c) {
+            for (int i = 0; i < frame_count; ++i) {
+                ASSERT_NEAR(output_signal[i * channel_count + c], expected[c * frame_count + i], 1e-5)
+                                            << "channel " << c << " of " << channel_count << ", frame " << i;
+            }
+        }
+    }
+
+    destroy_fir_filter(filter);
+}
+
+// A signal shorter than the kernel only has partially overlapping frames
+TEST(FIRFilterMultichannelTest, ShortInterleavedSignal) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    // Two channels, the second is the first negated
+    float input_signal[] = {1.0, -1.0, 2.0, -2.0, 3.0, -3.0};
+    float output_signal[6];
+    float expected[3];
+    float mono[] = {1.0, 2.0, 3.0};
+    apply_fir_filter(filter, mono, expected, 3);
+    apply_fir_filter_multichannel(filter, input_signal, output_signal, 3, 2, FIR_LAYOUT_INTERLEAVED);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(output_signal[2 * i], expected[i]);
+        ASSERT_EQ(output_signal[2 * i + 1], -expected[i]);
+    }
+    destroy_fir_filter(filter);
+}
+
+// Null and invalid channel count tests
+TEST(FIRFilterMultichannelTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0};
+    apply_fir_filter_multichannel(nullptr, input_signal, output_signal, 2, 2, FIR_LAYOUT_INTERLEAVED);
+    apply_fir_filter_multichannel(filter, nullptr, output_signal, 2, 2, FIR_LAYOUT_INTERLEAVED);
+    apply_fir_filter_multichannel(filter, input_signal, output_signal, 2, 0, FIR_LAYOUT_PLANAR);
+    apply_fir_filter_multichannel(filter, input_signal, output_signal, -1, 2, FIR_LAYOUT_PLANAR);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+    destroy_fir_filter(filter);
+}
+
+
+// ===============================
+// = UNIT TESTS: fir_filter_bank =
+// ===============================
+
+// Creates band filters of different types and cutoff frequencies
+static std::vector<FIRFilter *> create_band_filters(int filter_count, int kernel_length) {
+    std::vector<FIRFilter *> filters;
+    for (int k = 0; k < filter_count; ++k) {
+        FilterType type = (k % 2 == 0) ? LOW_PASS : HIGH_PASS;
+        // Alternate odd and even lengths, the cutoff at sample_rate / 4 gives a half-band filter
+        int length = kernel_length + (k % 3 == 1 ? 1 : 0);
+        float cutoff_freq = (k % 4 == 0) ? 12000.0f : 500.0f + 700.0f * k;
+        filters.push_back(create_fir_filter(type, HAMMING, cutoff_freq, length, 48000.0f));
+    }
+    return filters;
+}
+
+// The direct method must give the output of apply_fir_filter_simd for every filter
+TEST(FIRFilterBankTest, DirectMatchesApplySimd) {
+    const int filter_count = 16;
+    const int signal_length = 10000;
+    std::vector<FIRFilter *> filters = create_band_filters(filter_count, 31);
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<std::vector<float>> outputs(filter_count, std::vector<float>(signal_length));
+    std::vector<float *> output_signals;
+    for (auto &output : outputs) {
+        output_signals.push_back(output.data());
+    }
+    fill_random_signal(input_signal.data(), signal_length);
+
+    FIRFilterBank *bank = create_fir_filter_bank(filters.data(), filter_count, FIR_BANK_AUTO);
+    ASSERT_NE(bank, nullptr);
+    ASSERT_EQ(fir_filter_bank_method(bank), FIR_BANK_DIRECT);
+    apply_fir_filter_bank(bank, input_signal.data(), output_signals.data(), signal_length);
+
+    for (int k = 0; k < filter_count; ++k) {
+        apply_fir_filter_simd(filters[k], input_signal.data(), expected.data(), signal_length);
+        for (int i = 0; i < signal_length; ++i) {
+            ASSERT_EQ(outputs[k][i], expected[i]) << "filter " << k << ", sample " << i;
+        }
+        destroy_fir_filter(filters[k]);
+    }
+    destroy_fir_filter_bank(bank);
+}
+
+// The shared FFT must match the direct convolution of every filter, also for different kernel lengths
+TEST(FIRFilterBankTest, SharedFFTMatchesDirectConvolution) {
+    const int filter_count = 8;
+    std::vector<int> signal_lengths = {1, 100, 5000};
+    std::vector<FIRFilter *> filters = create_band_filters(filter_count, FIR_BANK_FFT_MIN_LENGTH + 1);
+    FIRFilter *short_filter = create_fir_filter(LOW_PASS, BLACKMAN, 3000.0f, 21, 48000.0f);
+
+    FIRFilterBank *bank = create_fir_filter_bank(filters.data(), filter_count, FIR_BANK_AUTO);
+    ASSERT_NE(bank, nullptr);
+    ASSERT_EQ(fir_filter_bank_method(bank), FIR_BANK_FFT);
+    // Forcing the FFT with a kernel much shorter than the others
+    filters.push_back(short_filter);
+    FIRFilterBank *mixed_bank = create_fir_filter_bank(filters.data(), filter_count + 1, FIR_BANK_FFT);
+    ASSERT_NE(mixed_bank, nullptr);
+    ASSERT_EQ(fir_filter_bank_method(mixed_bank), FIR_BANK_FFT);
+
+    for (int signal_length : signal_lengths) {
+        std::vector<float> input_signal(signal_length);
+        std::vector<float> expected(signal_length);
+        std::vector<std::vector<float>> outputs(filter_count + 1, std::vector<float>(signal_length));
+        std::vector<float *> output_signals;
+        for (auto &output : outputs) {
+            output_signals.push_back(output.data());
+        }
+        fill_random_signal(input_signal.data(), signal_length);
+
+        apply_fir_filter_bank(bank, input_signal.data(), output_signals.data(), signal_length);
+        for (int k = 0; k < filter_count; ++k) {
+            apply_fir_filter(filters[k], input_signal.data(), expected.data(), signal_length);
+            compare_arrays(outputs[k].data(), expected.data(), signal_length, 1e-4);
+        }
+
+        apply_fir_filter_bank(mixed_bank, input_signal.data(), output_signals.data(), signal_length);
+        for (int k = 0; k < filter_count + 1; ++k) {
+            apply_fir_filter(filters[k], input_signal.data(), expected.data(), signal_length);
+            compare_arrays(outputs[k].data(), expected.data(), signal_length, 1e-4);
+        }
+    }
+
+    for (FIRFilter *filter : filters) {
+        destroy_fir_filter(filter);
+    }
+    destroy_fir_filter_bank(bank);
+    destroy_fir_filter_bank(mixed_bank);
+}
+
+// Null and invalid filter tests
+TEST(FIRFilterBankTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRFilter *filters[] = {filter, nullptr};
+    ASSERT_EQ(create_fir_filter_bank(nullptr, 1, FIR_BANK_AUTO), nullptr);
+    ASSERT_EQ(create_fir_filter_bank(filters, 0, FIR_BANK_AUTO), nullptr);
+    ASSERT_EQ(create_fir_filter_bank(filters, 2, FIR_BANK_DIRECT), nullptr);
+
+    FIRFilterBank *bank = create_fir_filter_bank(filters, 1, FIR_BANK_DIRECT);
+    ASSERT_NE(bank, nullptr);
+    // The bank keeps its own copy of the coefficients
+    destroy_fir_filter(filter);
+
+    float input_signal[] = {1.0, 2.0, 3.0};
+    float output_signal[] = {0.0, 0.0, 0.0};
+    float *no_outputs[] = {nullptr};
+    apply_fir_filter_bank(bank, input_signal, no_outputs, 3);
+    apply_fir_filter_bank(bank, nullptr, no_outputs, 3);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+    float *output_signals[] = {output_signal};
+    apply_fir_filter_bank(bank, input_signal, output_signals, 3);
+    ASSERT_NE(output_signal[2], 0.0);
+
+    destroy_fir_filter_bank(bank);
+    destroy_fir_filter_bank(nullptr);
+}
+
+
+// ====================================
+// = UNIT TESTS: apply_fir_filter_fft =
+// ====================================
+
+// The FFT convolution must match the direct convolution for short and long kernels and signals
+TEST(FIRFilterApplyFFTTest, MatchesDirectConvolution) {
+    std::vector<int> kernel_lengths = {3, 11, 101, 1001, 4097};
+    std::vector<int> signal_lengths = {1, 10, 1000, 20000};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B8, 1000.0f, kernel_length, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            std::vector<float> expected(signal_length);
+            std::vector<float> output_signal(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+
+            apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+            apply_fir_filter_fft(filter, input_signal.data(), output_signal.data(), signal_length);
+            compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Same expected values as the direct convolution test
+TEST(FIRFilterApplyFFTTest, IsOutputSignalCalculationCorrect) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    float input_signal[] = {0.5, 1.5, 2.5, 3.5, 4.5, 10, 30, 50, 100};
+    float expected_output[] = {0.00000000, 0.00000000, 0.01296048, 0.09096559, 0.32284779, 0.78152296, 1.46699110,
+                               2.42298071, 4.28862617};
+    int signal_length = sizeof(input_signal) / sizeof(input_signal[0]);
+    float output_signal[sizeof(input_signal) / sizeof(input_signal[0])];
+
+    apply_fir_filter_fft(filter, input_signal, output_signal, signal_length);
+    compare_arrays(output_signal, expected_output, signal_length);
+
+    destroy_fir_filter(filter);
+}
+
+// Null tests
+TEST(FIRFilterApplyFFTTest, NullTests) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    int signal_length = sizeof(input_signal) / sizeof(input_signal[0]);
+
+    apply_fir_filter_fft(nullptr, input_signal, output_signal, signal_length);
+    apply_fir_filter_fft(filter, nullptr, output_signal, signal_length);
+    apply_fir_filter_fft(filter, input_signal, nullptr, signal_length);
+    // Expect no change in output signal
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_EQ(output_signal[i], 0.0);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+
+// ==================================
+// = UNIT TESTS: apply_fir_fft_plan =
+// ==================================
+
+// One plan reused over several signals must match the direct convolution of each of them
+TEST(FIRFilterFFTPlanTest, ReusedPlanMatchesDirectConvolution) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, BLACKMAN, 1000.0f, 1001, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRFFTPlan *plan = create_fir_fft_plan(filter, 0);
+    ASSERT_NE(plan, nullptr);
+    ASSERT_GE(fir_fft_plan_block_length(plan), 64);
+
+    std::vector<int> signal_lengths = {1, 500, 1001, 30000};
+    for (int k = 0; k < signal_lengths.size(); ++k) {
+        int signal_length = signal_lengths[k];
+        std::vector<float> input_signal(signal_length);
+        std::vector<float> expected(signal_length);
+        std::vector<float> output_signal(signal_length);
+        fill_random_signal(input_signal.data(), signal_length, k + 1);
+
+        apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+        apply_fir_fft_plan(plan, input_signal.data(), output_signal.data(), signal_length);
+        compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+    }
+
+    destroy_fir_fft_plan(plan);
+    destroy_fir_filter(filter);
+}
+
+// The block length can be chosen by the caller, the plan must not depend on the filter after creation
+TEST(FIRFilterFFTPlanTest, CustomBlockLength) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 500.0f, 63, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRFFTPlan *plan = create_fir_fft_plan(filter, 16);
+    ASSERT_NE(plan, nullptr);
+    ASSERT_GE(fir_fft_plan_block_length(plan), 16);
+
+    const int signal_length = 1000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+    destroy_fir_filter(filter);
+
+    apply_fir_fft_plan(plan, input_signal.data(), output_signal.data(), signal_length);
+    compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+    destroy_fir_fft_plan(plan);
+}
+
+// Null tests
+TEST(FIRFilterFFTPlanTest, NullTests) {
+    ASSERT_EQ(create_fir_fft_plan(nullptr, 0), nullptr);
+    destroy_fir_fft_plan(nullptr);
+    // Expect no crash
+}
+
+
+// =========================================
+// = UNIT TESTS: fir_partitioned_convolver =
+// =========================================
+
+// Streaming a long kernel in small blocks must match the direct convolution of the whole signal
+TEST(FIRPartitionedConvolverTest, MatchesDirectConvolution) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B10, 1000.0f, 4096, 48000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    const int signal_length = 16384;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+    std::vector<int> block_lengths = {64, 128, 8192};
+    for (int block_length : block_lengths) {
+        FIRPartitionedConvolver *convolver = create_fir_partitioned_convolver(filter, block_length);
+        ASSERT_NE(convolver, nullptr);
+        ASSERT_EQ(fir_partitioned_convolver_block_length(convolver), block_length);
+
+        // Feed the stream in chunks of one or several blocks
+        int start = 0;
+        for (int blocks = 1; start < signal_length; blocks = blocks % 3 + 1) {
+            int count = std::min(blocks * block_length, signal_length - start);
+            process_fir_partitioned_convolver(convolver, input_signal.data() + start, output_signal.data() + start,
+                                              count);
+            start += count;
+        }
+        compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+        destroy_fir_partitioned_convolver(convolver);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+// After a reset the convolver must forget the previous stream
+TEST(FIRPartitionedConvolverTest, Reset) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, HAMMING, 1000.0f, 301, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRPartitionedConvolver *convolver = create_fir_partitioned_convolver(filter, 32);
+    ASSERT_NE(convolver, nullptr);
+
+    const int signal_length = 1024;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+    process_fir_partitioned_convolver(convolver, input_signal.data(), output_signal.data(), signal_length);
+    reset_fir_partitioned_convolver(convolver);
+    process_fir_partitioned_convolver(convolver, input_signal.data(), output_signal.data(), signal_length);
+    compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+
+    destroy_fir_partitioned_convolver(convolver);
+    destroy_fir_filter(filter);
+}
+
+// Invalid block lengths and null tests
+TEST(FIRPartitionedConvolverTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_EQ(create_fir_partitioned_convolver(nullptr, 64), nullptr);
+    ASSERT_EQ(create_fir_partitioned_convolver(filter, 0), nullptr);
+    ASSERT_EQ(create_fir_partitioned_convolver(filter, 100), nullptr);
+
+    FIRPartitionedConvolver *convolver = create_fir_partitioned_convolver(filter, 4);
+    ASSERT_NE(convolver, nullptr);
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    // A length which is not a multiple of the block length is rejected without touching the output
+    process_fir_partitioned_convolver(convolver, input_signal, output_signal, 5);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+
+    destroy_fir_partitioned_convolver(convolver);
+    destroy_fir_partitioned_convolver(nullptr);
+    destroy_fir_filter(filter);
+}
+
+
+// ========================================
+// = UNIT TESTS: fir_nonuniform_convolver =
+// ========================================
+
+// Arbitrary chunk sizes must give the direct convolution with no latency, for short and long kernels
+TEST(FIRNonUniformConvolverTest, MatchesDirectConvolution) {
+    std::vector<int> kernel_lengths = {31, 1001, 9001};
+    std::vector<int> head_lengths = {16, 64};
+    const int signal_length = 30000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B8, 1000.0f, kernel_length, 48000.0f);
+        ASSERT_NE(filter, nullptr);
+        apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+        for (int head_length : head_lengths) {
+            FIRNonUniformConvolver *convolver = create_fir_nonuniform_convolver(filter, head_length);
+            ASSERT_NE(convolver, nullptr);
+
+            int start = 0;
+            for (int chunk = 1; start < signal_length; chunk = chunk * 7 % 150 + 1) {
+                int count = std::min(chunk, signal_length - start);
+                process_fir_nonuniform_convolver(convolver, input_signal.data() + start,
+                                                 output_signal.data() + start, count);
+                start += count;
+            }
+            compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+            destroy_fir_nonuniform_convolver(convolver);
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// After a reset the convolver must forget the previous stream, including the pending worker jobs
+TEST(FIRNonUniformConvolverTest, Reset) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, BLACKMAN, 1000.0f, 2001, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRNonUniformConvolver *convolver = create_fir_nonuniform_convolver(filter, 32);
+    ASSERT_NE(convolver, nullptr);
+
+    const int signal_length = 5000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+    process_fir_nonuniform_convolver(convolver, input_signal.data(), output_signal.data(), 3333);
+    reset_fir_nonuniform_convolver(convolver);
+    process_fir_nonuniform_convolver(convolver, input_signal.data(), output_signal.data(), signal_length);
+    compare_arrays(output_signal.data(), expected.data(), signal_length, 1e-4);
+
+    destroy_fir_nonuniform_convolver(convolver);
+    destroy_fir_filter(filter);
+}
+
+// Invalid head lengths and null tests
+TEST(FIRNonUniformConvolverTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    ASSERT_EQ(create_fir_nonuniform_convolver(nullptr, 64), nullptr);
+    ASSERT_EQ(create_fir_nonuniform_convolver(filter, 0), nullptr);
+    ASSERT_EQ(create_fir_nonuniform_convolver(filter, 48), nullptr);
+    destroy_fir_nonuniform_convolver(nullptr);
+    // Expect no crash
+    destroy_fir_filter(filter);
+}
+
+
+// ==================================
+// = UNIT TESTS: apply_fir_decimate =
+// ==================================
+
+// The decimated output must be every factor-th sample of the full-rate output
+TEST(FIRFilterDecimateTest, MatchesDownsampledDirectConvolution) {
+    std::vector<int> kernel_lengths = {3, 11, 101, 1001};
+    std::vector<int> factors = {1, 2, 3, 8, 13};
+    std::vector<int> signal_lengths = {1, 7, 1000, 10001};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, KAISER_B8, 1000.0f, kernel_length, 48000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            std::vector<float> full_rate(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+            apply_fir_filter(filter, input_signal.data(), full_rate.data(), signal_length);
+
+            for (int factor : factors) {
+                int output_length = fir_decimated_length(signal_length, factor);
+                ASSERT_EQ(output_length, (signal_length + factor - 1) / factor);
+                std::vector<float> output_signal(output_length);
+                apply_fir_decimate(filter, input_signal.data(), output_signal.data(), signal_length, factor);
+                for (int k = 0; k < output_length; ++k) {
+                    ASSERT_NEAR(output_signal[k], full_rate[k * factor], 1e-4);
+                }
+            }
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// A factor far above the kernel length only builds the phases with taps: one output of a short signal
+// needs a few bytes, not memory proportional to the factor
+TEST(FIRFilterDecimateTest, LargeFactorShortSignal) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HAMMING, 1000.0f, 101, 48000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    std::vector<float> input_signal(10);
+    fill_random_signal(input_signal.data(), 10);
+    for (int factor : {200000000, 2000000000, std::numeric_limits<int>::max()}) {
+        float output_signal = 0.0f;
+        ASSERT_EQ(fir_decimated_length(10, factor), 1);
+        ASSERT_EQ(apply_fir_decimate(filter, input_signal.data(), &output_signal, 10, factor), 0);
+        ASSERT_EQ(output_signal, filter->coefficients[0] * input_signal[0]) << "factor " << factor;
+    }
+    destroy_fir_filter(filter);
+}
+
+// Null tests and invalid factors
+TEST(FIRFilterDecimateTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    int signal_length = sizeof(input_signal) / sizeof(input_signal[0]);
+
+    apply_fir_decimate(nullptr, input_signal, output_signal, signal_length, 2);
+    apply_fir_decimate(filter, nullptr, output_signal, signal_length, 2);
+    apply_fir_decimate(filter, input_signal, nullptr, signal_length, 2);
+    apply_fir_decimate(filter, input_signal, output_signal, signal_length, 0);
+    // Expect no change in output signal
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_EQ(output_signal[i], 0.0);
+    }
+    ASSERT_EQ(fir_decimated_length(signal_length, 0), 0);
+
+    destroy_fir_filter(filter);
+}
+
+
+// =====================================
+// = UNIT TESTS: apply_fir_interpolate =
+// =====================================
+
+// The interpolated output must be the full-rate output of the zero-stuffed input
+TEST(FIRFilterInterpolateTest, MatchesZeroStuffedDirectConvolution) {
+    std::vector<int> kernel_lengths = {3, 11, 101, 1001};
+    std::vector<int> factors = {1, 2, 3, 8};
+    std::vector<int> signal_lengths = {1, 7, 1000, 2501};
+
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 1000.0f, kernel_length, 48000.0f);
+        ASSERT_NE(filter, nullptr);
+        for (int signal_length : signal_lengths) {
+            std::vector<float> input_signal(signal_length);
+            fill_random_signal(input_signal.data(), signal_length);
+
+            for (int factor : factors) {
+                int output_length = signal_length * factor;
+                std::vector<float> stuffed(output_length, 0.0f);
+                for (int i = 0; i < signal_length; ++i) {
+                    stuffed[i * factor] = input_signal[i];
+                }
+                std::vector<float> expected(output_length);
+                std::vector<float> output_signal(output_length);
+                apply_fir_filter(filter, stuffed.data(), expected.data(), output_length);
+                apply_fir_interpolate(filter, input_signal.data(), output_signal.data(), signal_length, factor);
+                compare_arrays(output_signal.data(), expected.data(), output_length, 1e-4);
+            }
+        }
+        destroy_fir_filter(filter);
+    }
+}
+
+// Null tests and invalid factors
+TEST(FIRFilterInterpolateTest, InvalidParameters) {
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+
+    float input_signal[] = {1.0, 2.0};
+    float output_signal[] = {0.0, 0.0, 0.0, 0.0};
+
+    apply_fir_interpolate(nullptr, input_signal, output_signal, 2, 2);
+    apply_fir_interpolate(filter, nullptr, output_signal, 2, 2);
+    apply_fir_interpolate(filter, input_signal, nullptr, 2, 2);
+    apply_fir_interpolate(filter, input_signal, output_signal, 2, -2);
+    // Expect no change in output signal
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+
+    destroy_fir_filter(filter);
+}
+
+
+// =============================
+// = UNIT TESTS: fir_resampler =
+// =============================
+
+// Helper function to resample by zero stuffing, filtering at the intermediate rate and downsampling
+std::vector<float> resample_by_hand(const FIRFilter *filter, const std::vector<float> &input, int up, int down) {
+    int stuffed_length = (int) input.size() * up;
+    std::vector<float> stuffed(stuffed_length, 0.0f);
+    for (int i = 0; i < input.size(); ++i) {
+        stuffed[i * up] = input[i];
+    }
+    std::vector<float> filtered(stuffed_length);
+    apply_fir_filter((FIRFilter *) filter, stuffed.data(), filtered.data(), stuffed_length);
+    std::vector<float> output;
+    for (int n = 0; n < stuffed_length; n += down) {
+        output.push_back(filtered[n]);
+    }
+    return output;
+}
+
+// Streaming in chunks of any size must match the upsample-filter-downsample pipeline
+TEST(FIRResamplerTest, MatchesUpsampleFilterDownsample) {
+    std::vector<std::pair<int, int>> ratios = {{48000, 44100}, {44100, 48000}, {2, 1}, {1, 3}, {96000, 48000}};
+    const int signal_length = 500;
+    std::vector<float> input_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    for (auto ratio : ratios) {
+        FIRResampler *resampler = create_fir_resampler(ratio.first, ratio.second, KAISER_B8, 0);
+        ASSERT_NE(resampler, nullptr);
+        int divisor = ratio.first;
+        for (int remainder = ratio.second; remainder != 0;) {
+            int t = divisor % remainder;
+            divisor = remainder;
+            remainder = t;
+        }
+        std::vector<float> expected = resample_by_hand(fir_resampler_filter(resampler), input_signal,
+                                                       ratio.first / divisor, ratio.second / divisor);
+
+        std::vector<float> output_signal;
+        int start = 0;
+        for (int chunk = 1; start < signal_length; chunk = chunk * 5 % 200 + 1) {
+            int count = std::min(chunk, signal_length - start);
+            std::vector<float> output_chunk(fir_resampler_max_output_length(resampler, count));
+            int produced = process_fir_resampler(resampler, input_signal.data() + start, count, output_chunk.data());
+            ASSERT_GE(produced, 0);
+            ASSERT_LE(produced, output_chunk.size());
+            output_signal.insert(output_signal.end(), output_chunk.begin(), output_chunk.begin() + produced);
+            start += count;
+        }
+
+        ASSERT_EQ(output_signal.size(), expected.size());
+        compare_arrays(output_signal.data(), expected.data(), (int) expected.size(), 1e-4);
+        destroy_fir_resampler(resampler);
+    }
+}
+
+// A sine well below both Nyquist frequencies keeps its amplitude
+TEST(FIRResamplerTest, PassbandGain) {
+    FIRResampler *resampler = create_fir_resampler(48000, 44100, BLACKMAN, 0);
+    ASSERT_NE(resampler, nullptr);
+
+    const int signal_length = 44100;
+    std::vector<float> input_signal(signal_length);
+    for (int i = 0; i < signal_length; ++i) {
+        input_signal[i] = (float) std::sin(2.0 * M_PI * 1000.0 * i / 44100.0);
+    }
+
+    std::vector<float> output_signal(fir_resampler_max_output_length(resampler, signal_length));
+    int produced = process_fir_resampler(resampler, input_signal.data(), signal_length, output_signal.data());
+    ASSERT_EQ(produced, 48000);
+    float peak = 0.0f;
+    for (int i = 24000; i < produced; ++i) {
+        peak = std::max(peak, std::fabs(output_signal[i]));
+    }
+    ASSERT_NEAR(peak, 1.0f, 1e-2);
+
+    destroy_fir_resampler(resampler);
+}
+
+// Reset and invalid parameters
+TEST(FIRResamplerTest, ResetAndInvalidParameters) {
+    ASSERT_EQ(create_fir_resampler(0, 1, HAMMING, 0), nullptr);
+    ASSERT_EQ(create_fir_resampler(1, -1, HAMMING, 0), nullptr);
+
+    FIRResampler *resampler = create_fir_resampler(3, 2, HAMMING, 61);
+    ASSERT_NE(resampler, nullptr);
+    float input_signal[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    float first[16], second[16];
+    int first_count = process_fir_resampler(resampler, input_signal, 6, first);
+    reset_fir_resampler(resampler);
+    int second_count = process_fir_resampler(resampler, input_signal, 6, second);
+    ASSERT_EQ(first_count, 9);
+    ASSERT_EQ(first_count, second_count);
+    for (int i = 0; i < first_count; ++i) {
+        ASSERT_EQ(first[i], second[i]);
+    }
+    ASSERT_EQ(process_fir_resampler(resampler, nullptr, 6, first), -1);
+
+    destroy_fir_resampler(resampler);
+    destroy_fir_resampler(nullptr);
+}
+
+
+// ==========================
+// = UNIT TESTS: fir_stream =
+// ==========================
+
+// Streaming in chunks of any size must be sample-identical to one apply_fir_filter call
+TEST(FIRStreamTest, MatchesApplyFirFilterExactly) {
+    const int signal_length = 3000;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+
+    // Kernels shorter and longer than the chunks, including a single tap
+    std::vector<int> kernel_lengths = {1, 2, 31, 257};
+    for (int kernel_length : kernel_lengths) {
+        FIRFilter *filter = create_fir_filter(LOW_PASS, BLACKMAN, 1000.0f, 3, 8000.0f);
+        ASSERT_NE(filter, nullptr);
+        free(filter->coefficients);
+        filter->kernel_length = kernel_length;
+        filter->coefficients = (float *) malloc(kernel_length * sizeof(float));
+        fill_random_signal(filter->coefficients, kernel_length, 7);
+        apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+        FIRStream *stream = create_fir_stream(filter);
+        ASSERT_NE(stream, nullptr);
+        int start = 0;
+        for (int chunk = 0; start < signal_length; ++chunk) {
+            int count = std::min(chunk * 7 % 100, signal_length - start);
+            process_fir_stream(stream, input_signal.data() + start, output_signal.data() + start, count);
+            start += count;
+        }
+        for (int i = 0; i < signal_length; ++i) {
+            ASSERT_EQ(output_signal[i], expected[i]) << "kernel_length " << kernel_length << ", sample " << i;
+        }
+
+        destroy_fir_stream(stream);
+        destroy_fir_filter(filter);
+    }
+}
+
+// After a reset the stream must forget the previous samples
+TEST(FIRStreamTest, Reset) {
+    FIRFilter *filter = create_fir_filter(HIGH_PASS, HAMMING, 1000.0f, 51, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRStream *stream = create_fir_stream(filter);
+    ASSERT_NE(stream, nullptr);
+
+    const int signal_length = 200;
+    std::vector<float> input_signal(signal_length);
+    std::vector<float> expected(signal_length);
+    std::vector<float> output_signal(signal_length);
+    fill_random_signal(input_signal.data(), signal_length);
+    apply_fir_filter(filter, input_signal.data(), expected.data(), signal_length);
+
+    process_fir_stream(stream, input_signal.data(), output_signal.data(), signal_length);
+    reset_fir_stream(stream);
+    process_fir_stream(stream, input_signal.data(), output_signal.data(), signal_length);
+    for (int i = 0; i < signal_length; ++i) {
+        ASSERT_EQ(output_signal[i], expected[i]);
+    }
+
+    destroy_fir_stream(stream);
+    destroy_fir_filter(filter);
+}
+
+// Null tests
+TEST(FIRStreamTest, InvalidParameters) {
+    ASSERT_EQ(create_fir_stream(nullptr), nullptr);
+
+    FIRFilter *filter = create_fir_filter(LOW_PASS, HANNING, 1000.0f, 11, 8000.0f);
+    ASSERT_NE(filter, nullptr);
+    FIRStream *stream = create_fir_stream(filter);
+    ASSERT_NE(stream, nullptr);
+    float output_signal[] = {0.0, 0.0, 0.0};
+    process_fir_stream(stream, nullptr, output_signal, 3);
+    process_fir_stream(nullptr, output_signal, output_signal, 3);
+    for (float value : output_signal) {
+        ASSERT_EQ(value, 0.0);
+    }
+
+    destroy_fir_stream(stream);
+    destroy_fir_stream(nullptr);
+    destroy_fir_filter(filter);
+}
+
+
 // ==================================
 // = UNIT TESTS: destroy_fir_filter =
 // ==================================